@@ -0,0 +1,32 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include "runtime/program.h"
+#include "runtime/interpreter.h"
+#include "common/format.h"
+
+// Interpreter throughput on nested loops. The innermost one steps its counter
+// by two, so it isn't lowered to a multiplication and every iteration is
+// dispatched.
+int main()
+{
+    Program program("++++++++++++++++[>-[>-[>--[>+<--]<-]<-]<-]");
+    std::stringstream input, output;
+
+    double best = 0;
+    uint64_t executed = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        Interpreter interpreter;
+        auto start = std::chrono::steady_clock::now();
+        interpreter.run(program, input, output);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        executed = interpreter.getExecutedInstructions();
+        if (i == 0 || seconds < best)
+            best = seconds;
+    }
+
+    fmt::printf("Interpreter: ", executed, " instructions in ", best, "s (", (uint64_t) (executed / best),
+        " per second, best of 5)\n");
+}
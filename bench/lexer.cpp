@@ -0,0 +1,35 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "parser/lexer.h"
+#include "common/format.h"
+
+// Lexes identifiers from memory, every other one a keyword
+int main()
+{
+    const char* words[] = {"while", "counter", "return", "value", "u8", "index", "func", "total"};
+    const size_t count = 3200000;
+
+    std::string source;
+    for (size_t i = 0; i < count; ++i)
+    {
+        source += words[i % 8];
+        source += ' ';
+    }
+
+    double best = 0;
+    size_t tokens = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        Lexer lexer(source);
+        auto start = std::chrono::steady_clock::now();
+        tokens = 0;
+        while (lexer.nextSignificant().type != TokenType::EOI)
+            tokens++;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || seconds < best)
+            best = seconds;
+    }
+
+    fmt::printf("Lexer: ", tokens, " tokens in ", best, "s (best of 5)\n");
+}
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include "generator/brainfuck.h"
+#include "common/format.h"
+
+// Runs the u8 arithmetic routines of the writer on every pair of operands,
+// with garbage in the cells above the stack, and counts brainfuck steps.
+
+typedef std::function<void(BrainfuckWriter&)> Routine;
+typedef std::function<bool(int, int, const uint8_t*)> Check;
+
+// mulU8 before the nested transfer loop, adding x to the product once for
+// every unit of y
+static void oldMulU8(BrainfuckWriter& writer)
+{
+    size_t x = writer.getStackLocation() - 2;
+    size_t y = writer.getStackLocation() - 1;
+    size_t temp = writer.getStackLocation();
+    size_t temp2 = temp + 1;
+    size_t temp3 = temp + 2;
+    size_t temp4 = temp + 3;
+
+    writer.loadValue(y, 1);
+    writer.loadValue(x, 1);
+    writer.moveStackPointerTo(x);
+    writer.clearByte();
+    writer.moveStackPointerTo(temp);
+    writer.branchOpen();
+    writer.moveStackPointerTo(temp3);
+    writer.loadValue(x, 1);
+    writer.loadValue(temp2, 1);
+    writer.addU8();
+    writer.copyByte(temp3, x, temp4);
+    writer.moveStackPointerTo(temp);
+    writer.decrement();
+    writer.branchClose();
+    writer.moveStackPointerTo(y);
+}
+
+static void measure(const char* name, const Routine& routine, size_t results, const Check& check)
+{
+    std::stringstream output;
+    BrainfuckWriter writer(output);
+    writer.incrementStackPointerBy(2);
+    routine(writer);
+    writer.flush();
+    bool balanced = writer.getStackLocation() == results;
+
+    // Runs of + - < > are executed at once, and so are loops that only move
+    // their counter elsewhere, but every instruction still counts as a step
+    struct Step
+    {
+        char op;
+        uint32_t count;
+        size_t jump;
+        // Steps of one iteration and the changes it makes around the counter,
+        // for transfer loops
+        uint64_t body;
+        std::vector<std::pair<int, int>> changes;
+    };
+    std::vector<Step> code;
+    std::vector<size_t> open;
+    size_t instructions = 0;
+    for (char c : output.str())
+    {
+        if (c != '+' && c != '-' && c != '<' && c != '>' && c != '[' && c != ']')
+            continue;
+        instructions++;
+        if (c == '[')
+        {
+            open.push_back(code.size());
+            code.push_back(Step{c, 1, 0, 0, {}});
+        }
+        else if (c == ']')
+        {
+            Step& loop = code[open.back()];
+            loop.jump = code.size();
+            code.push_back(Step{c, 1, open.back(), 0, {}});
+
+            int offset = 0, counter = 0;
+            uint64_t body = 1;
+            std::vector<std::pair<int, int>> changes;
+            bool transfer = true;
+            for (size_t i = open.back() + 1; i + 1 < code.size() && transfer; ++i)
+            {
+                const Step& step = code[i];
+                body += step.count;
+                if (step.op == '>' || step.op == '<')
+                    offset += step.op == '>' ? step.count : -(int) step.count;
+                else if (step.op != '+' && step.op != '-')
+                    transfer = false;
+                else if (offset == 0)
+                    counter += step.op == '+' ? step.count : -(int) step.count;
+                else
+                    changes.emplace_back(offset, step.op == '+' ? step.count : -(int) step.count);
+            }
+            if (transfer && offset == 0 && (counter & 0xFF) == 0xFF)
+            {
+                loop.body = body;
+                loop.changes = changes;
+            }
+            open.pop_back();
+        }
+        else if (!code.empty() && code.back().op == c)
+        {
+            code.back().count++;
+        }
+        else
+        {
+            code.push_back(Step{c, 1, 0, 0, {}});
+        }
+    }
+
+    uint64_t total = 0, worst = 0;
+    size_t wrong = 0;
+    for (int x = 0; x < 256; ++x)
+    {
+        for (int y = 0; y < 256; ++y)
+        {
+            uint8_t tape[32] = {(uint8_t) x, (uint8_t) y, 77, 99, 55, 33, 12, 200, 1};
+            size_t pointer = 0;
+            uint64_t steps = 0;
+            for (size_t i = 0; i < code.size(); ++i)
+            {
+                const Step& step = code[i];
+                steps += step.count;
+                switch (step.op)
+                {
+                    case '+': tape[pointer] += step.count; break;
+                    case '-': tape[pointer] -= step.count; break;
+                    case '>': pointer += step.count; break;
+                    case '<': pointer -= step.count; break;
+                    case '[':
+                        if (step.body != 0)
+                        {
+                            // The counter steps down by one, so the loop runs as many times as it says
+                            uint64_t times = tape[pointer];
+                            for (const std::pair<int, int>& change : step.changes)
+                                tape[pointer + change.first] += times * change.second;
+                            tape[pointer] = 0;
+                            steps += times * step.body;
+                            i = step.jump;
+                        }
+                        else if (!tape[pointer])
+                        {
+                            i = step.jump;
+                        }
+                        break;
+                    case ']': if (tape[pointer]) i = step.jump; break;
+                }
+            }
+            wrong += !balanced || pointer != results || !check(x, y, tape);
+            total += steps;
+            worst = std::max(worst, steps);
+        }
+    }
+
+    fmt::printf(name, ": ", instructions, " instructions, ", total, " steps, worst case ", worst,
+        wrong == 0 ? ", all correct\n" : ", WRONG\n");
+}
+
+int main()
+{
+    auto quotient = [](int x, int y) { return y == 0 ? 0 : x / y; };
+    auto remainder = [](int x, int y) { return y == 0 ? x : x % y; };
+    auto shifted = [](int x, int y, bool left) { return y >= 8 ? 0 : left ? x << y : x >> y; };
+
+    measure("mulU8 (old)", oldMulU8, 1, [](int x, int y, const uint8_t* tape) { return tape[0] == (uint8_t) (x * y); });
+    measure("mulU8", [](BrainfuckWriter& w) { w.mulU8(); }, 1, [](int x, int y, const uint8_t* tape) { return tape[0] == (uint8_t) (x * y); });
+    measure("divU8", [](BrainfuckWriter& w) { w.divU8(); }, 1, [&](int x, int y, const uint8_t* tape) { return tape[0] == quotient(x, y); });
+    measure("modU8", [](BrainfuckWriter& w) { w.modU8(); }, 1, [&](int x, int y, const uint8_t* tape) { return tape[0] == remainder(x, y); });
+    measure("divModU8", [](BrainfuckWriter& w) { w.divModU8(); }, 2, [&](int x, int y, const uint8_t* tape)
+    {
+        return tape[0] == quotient(x, y) && tape[1] == remainder(x, y);
+    });
+    measure("shlU8", [](BrainfuckWriter& w) { w.shlU8(); }, 1, [&](int x, int y, const uint8_t* tape) { return tape[0] == (uint8_t) shifted(x, y, true); });
+    measure("shrU8", [](BrainfuckWriter& w) { w.shrU8(); }, 1, [&](int x, int y, const uint8_t* tape) { return tape[0] == shifted(x, y, false); });
+}
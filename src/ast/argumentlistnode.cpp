@@ -1,17 +1,12 @@
 #include "ast/argumentlistnode.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
 ArgumentListNode::ArgumentListNode(const std::vector<ExpressionNode*>& arguments):
     arguments(arguments) {}
 
-ArgumentListNode::~ArgumentListNode()
-{
-    for(auto& it : this->arguments)
-        delete it;
-}
-
 void ArgumentListNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -20,10 +15,12 @@ void ArgumentListNode::print(std::ostream& os, size_t level) const
         it->print(os, level+1);
 }
 
-void ArgumentListNode::generate(BrainfuckWriter& writer)
+std::vector<IrValue> ArgumentListNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    std::vector<IrValue> values;
+    for(ExpressionNode* argument : this->arguments)
+        values.push_back(argument->lower(builder));
+    return values;
 }
 
 void ArgumentListNode::declareGlobals(BrainfuckWriter& writer)
@@ -38,10 +35,16 @@ void ArgumentListNode::checkTypes(BrainfuckWriter& writer)
         expression->checkTypes(writer);
 }
 
-std::vector<DataTypeBase*> ArgumentListNode::getArgumentTypes()
+std::vector<const DataTypeBase*> ArgumentListNode::getArgumentTypes()
 {
-    std::vector<DataTypeBase*> result;
+    std::vector<const DataTypeBase*> result;
     for(ExpressionNode* expr : this->arguments)
         result.push_back(expr->getType());
     return result;
 }
+
+void ArgumentListNode::foldConstants(Arena& arena)
+{
+    for(auto& it : this->arguments)
+        it = it->fold(arena);
+}
@@ -10,14 +10,15 @@ class ArgumentListNode : public Node
         std::vector<ExpressionNode*> arguments;
     public:
         ArgumentListNode(const std::vector<ExpressionNode*>& arguments);
-        virtual ~ArgumentListNode();
+        virtual ~ArgumentListNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        std::vector<IrValue> lower(IrBuilder&);
         virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
 
-        std::vector<DataTypeBase*> getArgumentTypes();
+        std::vector<const DataTypeBase*> getArgumentTypes();
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -8,18 +8,20 @@
 class AssemblyNode : public ExpressionNode
 {
     private:
-        DataTypeBase* datatype;
+        const DataTypeBase* datatype;
         std::string assembly;
         ArgumentListNode* arguments;
+        //Only reads its arguments, so it can be removed when its value is unused
+        bool pure;
     public:
-        AssemblyNode(DataTypeBase*, const std::string&, ArgumentListNode*);
-        virtual ~AssemblyNode();
+        AssemblyNode(const DataTypeBase*, const std::string&, ArgumentListNode*, bool pure);
+        virtual ~AssemblyNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -1,6 +1,7 @@
 #include "ast/expr/assignmentnode.h"
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <sstream>
@@ -9,12 +10,6 @@
 AssignmentNode::AssignmentNode(ExpressionNode* name, ExpressionNode* expr):
     lop(name), rop(expr) {}
 
-AssignmentNode::~AssignmentNode()
-{
-    delete this->lop;
-    delete this->rop;
-}
-
 void AssignmentNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -23,10 +18,18 @@ void AssignmentNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void AssignmentNode::generate(BrainfuckWriter& writer)
+IrValue AssignmentNode::lower(IrBuilder& builder)
+{
+    IrValue value = this->rop->lower(builder);
+    this->lop->lowerStore(builder, value);
+    return value;
+}
+
+void AssignmentNode::declareGlobals(BrainfuckWriter& writer)
 {
-    ///TODO
-    writer.unimplemented();
+    //Initialized global declarations
+    this->lop->declareGlobals(writer);
+    this->rop->declareGlobals(writer);
 }
 
 void AssignmentNode::checkTypes(BrainfuckWriter& writer)
@@ -34,10 +37,10 @@ void AssignmentNode::checkTypes(BrainfuckWriter& writer)
     this->lop->checkTypes(writer);
     this->rop->checkTypes(writer);
 
-    std::unique_ptr<DataTypeBase> lop_type(this->lop->getType());
-    std::unique_ptr<DataTypeBase> rop_type(this->rop->getType());
+    const DataTypeBase* lop_type = this->lop->getType();
+    const DataTypeBase* rop_type = this->rop->getType();
 
-    if(!lop_type->equals(*rop_type))
+    if(lop_type != rop_type)
     {
         std::stringstream ss;
         ss << "Type mismatch in assignment: left operand type: " << *lop_type << ", right operand type " << *rop_type << std::endl;
@@ -45,13 +48,12 @@ void AssignmentNode::checkTypes(BrainfuckWriter& writer)
     }
 }
 
-DataTypeBase* AssignmentNode::getType()
+const DataTypeBase* AssignmentNode::getType()
 {
     return this->lop->getType();
 }
 
-void AssignmentNode::declareLocals(BrainfuckWriter& writer)
+void AssignmentNode::foldConstants(Arena& arena)
 {
-    this->lop->declareLocals(writer);
-    this->rop->declareLocals(writer);
+    this->rop = this->rop->fold(arena);
 }
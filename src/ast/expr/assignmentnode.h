@@ -10,13 +10,14 @@ class AssignmentNode : public ExpressionNode
         ExpressionNode* rop;
     public:
         AssignmentNode(ExpressionNode*, ExpressionNode*);
-        virtual ~AssignmentNode();
+        virtual ~AssignmentNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
+        virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
 };
 
 #endif
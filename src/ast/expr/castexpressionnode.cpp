@@ -1,22 +1,19 @@
 #include "ast/expr/castexpressionnode.h"
+#include "ast/expr/u8constantnode.h"
+#include "common/arena.h"
 #include "types/datatype.h"
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
 #include <sstream>
 
-CastExpressionNode::CastExpressionNode(ExpressionNode* expression, DataTypeBase* desired_type):
+CastExpressionNode::CastExpressionNode(ExpressionNode* expression, const DataTypeBase* desired_type):
     expression(expression), desired_type(desired_type) {}
 
-CastExpressionNode::~CastExpressionNode()
-{
-    delete this->expression;
-    delete this->desired_type;
-}
-
 void CastExpressionNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -24,17 +21,17 @@ void CastExpressionNode::print(std::ostream& os, size_t level) const
     this->expression->print(os, level+1);
 }
 
-void CastExpressionNode::generate(BrainfuckWriter& writer)
+IrValue CastExpressionNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    IrValue value = this->expression->lower(builder);
+    return builder.unary(IrOpcode::CAST, this->desired_type, value);
 }
 
 void CastExpressionNode::checkTypes(BrainfuckWriter& writer)
 {
     this->expression->checkTypes(writer);
 
-    std::unique_ptr<DataTypeBase> expression_type(this->expression->getType());
+    const DataTypeBase* expression_type = this->expression->getType();
 
     if(!this->desired_type->canCastFrom(*expression_type))
     {
@@ -44,12 +41,22 @@ void CastExpressionNode::checkTypes(BrainfuckWriter& writer)
     }
 }
 
-DataTypeBase* CastExpressionNode::getType()
+const DataTypeBase* CastExpressionNode::getType()
 {
-    return this->desired_type->copy();
+    return this->desired_type;
 }
 
-void CastExpressionNode::declareLocals(BrainfuckWriter& writer)
+void CastExpressionNode::foldConstants(Arena& arena)
 {
-    UNUSED(writer);
+    this->expression = this->expression->fold(arena);
+}
+
+ExpressionNode* CastExpressionNode::fold(Arena& arena)
+{
+    this->foldConstants(arena);
+
+    U8ConstantNode* constant = dynamic_cast<U8ConstantNode*>(this->expression);
+    if(constant != nullptr && this->desired_type->type == DataTypeClass::U8)
+        return arena.create<U8ConstantNode>(constant->getValue());
+    return this;
 }
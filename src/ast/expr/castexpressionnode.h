@@ -7,16 +7,17 @@ class CastExpressionNode : public ExpressionNode
 {
     private:
         ExpressionNode* expression;
-        DataTypeBase* desired_type;
+        const DataTypeBase* desired_type;
     public:
-        CastExpressionNode(ExpressionNode*, DataTypeBase*);
-        virtual ~CastExpressionNode();
+        CastExpressionNode(ExpressionNode*, const DataTypeBase*);
+        virtual ~CastExpressionNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
+        virtual ExpressionNode* fold(Arena&);
 };
 
 #endif
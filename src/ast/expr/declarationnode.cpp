@@ -3,18 +3,14 @@
 #include "except/exceptions.h"
 #include "common/util.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
 #include <sstream>
 
-DeclarationNode::DeclarationNode(DataTypeBase* type, const std::string& name):
-    datatype(type), variable(name) {}
-
-DeclarationNode::~DeclarationNode()
-{
-    delete this->datatype;
-}
+DeclarationNode::DeclarationNode(const DataTypeBase* type, Symbol name):
+    datatype(type), variable(name), slot(nullptr) {}
 
 void DeclarationNode::print(std::ostream& os, size_t level) const
 {
@@ -26,28 +22,37 @@ void DeclarationNode::checkTypes(BrainfuckWriter& writer)
 {
     if(writer.getScope() != GLOBAL_SCOPE)
     {
-        writer.declareVariable(this->variable, this->datatype);
+        this->slot = writer.declareVariable(this->variable, this->datatype);
     }
 }
 
 void DeclarationNode::declareGlobals(BrainfuckWriter& writer)
 {
-    writer.declareVariable(this->variable, this->datatype);
+    this->slot = writer.declareVariable(this->variable, this->datatype);
 }
 
 
-void DeclarationNode::generate(BrainfuckWriter& writer)
+IrValue DeclarationNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    if(this->datatype != TypeTable::get<DataTypeClass::U8>())
+    {
+        ///TODO
+        return builder.unimplemented(this->datatype);
+    }
+
+    //Locals are zero initialized, globals start out zero
+    IrValue zero = builder.constant(this->datatype, 0);
+    if(!this->slot->global)
+        builder.store(this->datatype, this->slot, zero);
+    return zero;
 }
 
-DataTypeBase* DeclarationNode::getType()
+void DeclarationNode::lowerStore(IrBuilder& builder, IrValue value)
 {
-    return this->datatype->copy();
+    builder.store(this->datatype, this->slot, value);
 }
 
-void DeclarationNode::declareLocals(BrainfuckWriter& writer)
+const DataTypeBase* DeclarationNode::getType()
 {
-    writer.declareVariable(this->variable, this->datatype);
+    return this->datatype;
 }
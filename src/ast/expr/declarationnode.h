@@ -2,22 +2,24 @@
 #define SRC_AST_EXPR_DECLARATIONNODE_H_
 
 #include "ast/expr/expressionnode.h"
+#include "generator/variableslot.h"
 
 class DeclarationNode: public ExpressionNode
 {
     private:
-        DataTypeBase* datatype;
-        std::string variable;
+        const DataTypeBase* datatype;
+        Symbol variable;
+        const VariableSlot* slot;
     public:
-        DeclarationNode(DataTypeBase*, const std::string&);
-        virtual ~DeclarationNode();
+        DeclarationNode(const DataTypeBase*, Symbol);
+        virtual ~DeclarationNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
+        virtual void lowerStore(IrBuilder&, IrValue);
         virtual void checkTypes(BrainfuckWriter&);
         virtual void declareGlobals(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
 };
 
 #endif
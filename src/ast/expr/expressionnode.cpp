@@ -0,0 +1,16 @@
+#include "ast/expr/expressionnode.h"
+#include "ir/builder.h"
+#include "common/util.h"
+
+ExpressionNode* ExpressionNode::fold(Arena& arena)
+{
+    this->foldConstants(arena);
+    return this;
+}
+
+void ExpressionNode::lowerStore(IrBuilder& builder, IrValue value)
+{
+    ///TODO: only variables can be assigned to so far
+    UNUSED(value);
+    builder.unimplemented(TypeTable::get<DataTypeClass::VOID>());
+}
@@ -9,8 +9,16 @@ class ExpressionNode : public Node
     public:
         virtual ~ExpressionNode() = default;
 
-        virtual DataTypeBase* getType() = 0;
-        virtual void declareLocals(BrainfuckWriter&) = 0;
+        virtual const DataTypeBase* getType() = 0;
+
+        //Appends the evaluation of the expression to the IR, returning its value
+        virtual IrValue lower(IrBuilder&) = 0;
+        //Stores the value into what the expression names, for assignments
+        virtual void lowerStore(IrBuilder&, IrValue);
+
+        //Folds the expression, returning either itself or a replacement
+        //node allocated from the arena
+        virtual ExpressionNode* fold(Arena&);
 };
 
 #endif
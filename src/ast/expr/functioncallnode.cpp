@@ -2,19 +2,14 @@
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <sstream>
 
-FunctionCallNode::FunctionCallNode(const std::string& function_var, ArgumentListNode* arguments):
+FunctionCallNode::FunctionCallNode(Symbol function_var, ArgumentListNode* arguments):
     function_var(function_var), arguments(arguments), called_type(nullptr) {}
 
-FunctionCallNode::~FunctionCallNode()
-{
-    delete this->arguments;
-    delete this->called_type;
-}
-
 void FunctionCallNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -22,55 +17,43 @@ void FunctionCallNode::print(std::ostream& os, size_t level) const
     this->arguments->print(os, level+1);
 }
 
-void FunctionCallNode::generate(BrainfuckWriter& writer)
+IrValue FunctionCallNode::lower(IrBuilder& builder)
 {
     ///TODO
-    writer.unimplemented();
+    return builder.unimplemented(this->called_type);
 }
 
 void FunctionCallNode::checkTypes(BrainfuckWriter& writer)
 {
     this->arguments->checkTypes(writer);
 
-    std::vector<DataTypeBase*> arg_types = this->arguments->getArgumentTypes();
-    try
+    std::vector<const DataTypeBase*> arg_types = this->arguments->getArgumentTypes();
+    FunctionDefinition* definition = writer.getDeclaredFunction(this->function_var, arg_types);
+    if(definition == nullptr)
     {
-        FunctionDefinition* definition = writer.getDeclaredFunction(this->function_var, arg_types);
-        if(definition == nullptr)
+        std::stringstream ss;
+        ss << "Attempt to call undeclared function " << this->function_var << "(";
+        bool first = true;
+        for(const DataTypeBase* dtype : arg_types)
         {
-            std::stringstream ss;
-            ss << "Attempt to call undeclared function " << this->function_var << "(";
-            bool first = true;
-            for(DataTypeBase* dtype : arg_types)
-            {
-                if(!first)
-                    ss << ", ";
-                else
-                    first = false;
-                ss << *dtype;
-            }
-            ss << ")";
-            throw TypeCheckException(ss.str());
+            if(!first)
+                ss << ", ";
+            else
+                first = false;
+            ss << *dtype;
         }
-        this->called_type = definition->getReturnType();
-
-        for(DataTypeBase* dtype : arg_types)
-            delete dtype;
-    }
-    catch(...)
-    {
-        for(DataTypeBase* dtype : arg_types)
-            delete dtype;
-        throw;
+        ss << ")";
+        throw TypeCheckException(ss.str());
     }
+    this->called_type = definition->getReturnType();
 }
 
-DataTypeBase* FunctionCallNode::getType()
+const DataTypeBase* FunctionCallNode::getType()
 {
     return this->called_type;
 }
 
-void FunctionCallNode::declareLocals(BrainfuckWriter& writer)
+void FunctionCallNode::foldConstants(Arena& arena)
 {
-    UNUSED(writer);
+    this->arguments->foldConstants(arena);
 }
@@ -1,25 +1,24 @@
 #ifndef SRC_AST_EXPR_FUNCTIONCALLNODE_H_
 #define SRC_AST_EXPR_FUNCTIONCALLNODE_H_
 
-#include <string>
 #include "ast/expr/expressionnode.h"
 #include "ast/argumentlistnode.h"
 
 class FunctionCallNode : public ExpressionNode
 {
     private:
-        std::string function_var;
+        Symbol function_var;
         ArgumentListNode* arguments;
-        DataTypeBase* called_type;
+        const DataTypeBase* called_type;
     public:
-        FunctionCallNode(const std::string&, ArgumentListNode*);
-        virtual ~FunctionCallNode();
+        FunctionCallNode(Symbol, ArgumentListNode*);
+        virtual ~FunctionCallNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
 };
 
 #endif
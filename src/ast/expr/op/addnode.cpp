@@ -14,10 +14,13 @@ void AddNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void AddNode::generate(BrainfuckWriter& writer)
+IrOpcode AddNode::getOpcode() const
 {
-    if(this->type->equals(DataType<DataTypeClass::U8>()))
-        writer.addU8();
-    else
-        writer.unimplemented();
+    return IrOpcode::ADD;
+}
+
+bool AddNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs + rhs;
+    return true;
 }
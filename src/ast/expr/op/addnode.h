@@ -10,7 +10,8 @@ class AddNode : public BinaryOperatorNode
         virtual ~AddNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrOpcode getOpcode() const;
+        virtual bool evaluate(uint8_t, uint8_t, uint8_t&) const;
 };
 
 #endif
@@ -1,5 +1,8 @@
 #include "ast/expr/op/binaryoperatornode.h"
+#include "ast/expr/u8constantnode.h"
+#include "common/arena.h"
 #include "except/exceptions.h"
+#include "ir/builder.h"
 
 #include <sstream>
 #include <memory>
@@ -7,21 +10,21 @@
 BinaryOperatorNode::BinaryOperatorNode(ExpressionNode* lop, ExpressionNode* rop)
     : lop(lop), rop(rop), type(nullptr) {}
 
-BinaryOperatorNode::~BinaryOperatorNode()
+IrValue BinaryOperatorNode::lower(IrBuilder& builder)
 {
-    delete this->lop;
-    delete this->rop;
-    delete this->type;
+    IrValue lhs = this->lop->lower(builder);
+    IrValue rhs = this->rop->lower(builder);
+    return builder.binary(this->getOpcode(), this->type, lhs, rhs);
 }
 
 void BinaryOperatorNode::checkTypes(BrainfuckWriter& writer)
 {
     this->lop->checkTypes(writer);
     this->rop->checkTypes(writer);
-    std::unique_ptr<DataTypeBase> lop_type(this->lop->getType());
-    std::unique_ptr<DataTypeBase> rop_type(this->rop->getType());
+    const DataTypeBase* lop_type = this->lop->getType();
+    const DataTypeBase* rop_type = this->rop->getType();
 
-    if(!lop_type->equals(*rop_type))
+    if(lop_type != rop_type)
     {
         std::stringstream ss;
         ss << "Binary operation on different types: ";
@@ -35,16 +38,28 @@ void BinaryOperatorNode::checkTypes(BrainfuckWriter& writer)
         ss << *lop_type;
         throw TypeMismatchException(ss.str());
     }
-    this->type = lop_type.release();
+    this->type = lop_type;
 }
 
-DataTypeBase* BinaryOperatorNode::getType()
+const DataTypeBase* BinaryOperatorNode::getType()
 {
-    return this->type->copy();
+    return this->type;
 }
 
-void BinaryOperatorNode::declareLocals(BrainfuckWriter& writer)
+void BinaryOperatorNode::foldConstants(Arena& arena)
 {
-    this->lop->declareLocals(writer);
-    this->rop->declareLocals(writer);
+    this->lop = this->lop->fold(arena);
+    this->rop = this->rop->fold(arena);
+}
+
+ExpressionNode* BinaryOperatorNode::fold(Arena& arena)
+{
+    this->foldConstants(arena);
+
+    U8ConstantNode* lhs = dynamic_cast<U8ConstantNode*>(this->lop);
+    U8ConstantNode* rhs = dynamic_cast<U8ConstantNode*>(this->rop);
+    uint8_t result;
+    if(lhs != nullptr && rhs != nullptr && this->evaluate(lhs->getValue(), rhs->getValue(), result))
+        return arena.create<U8ConstantNode>(result);
+    return this;
 }
@@ -1,6 +1,7 @@
 #ifndef SRC_AST_EXPR_OP_BINARYEXPRESSIONNODE_H_
 #define SRC_AST_EXPR_OP_BINARYEXPRESSIONNODE_H_
 
+#include <cstdint>
 #include "ast/expr/expressionnode.h"
 
 class BinaryOperatorNode : public ExpressionNode
@@ -8,15 +9,23 @@ class BinaryOperatorNode : public ExpressionNode
     protected:
         ExpressionNode* lop;
         ExpressionNode* rop;
-        DataTypeBase* type;
+        const DataTypeBase* type;
 
         BinaryOperatorNode(ExpressionNode*, ExpressionNode*);
     public:
-        virtual ~BinaryOperatorNode();
+        virtual ~BinaryOperatorNode() = default;
 
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
+        virtual ExpressionNode* fold(Arena&);
+        virtual IrValue lower(IrBuilder&);
+
+        virtual IrOpcode getOpcode() const = 0;
+
+        //Computes the operation on two u8 values, wrapping modulo 256.
+        //Returns false if the result can't be known at compile time.
+        virtual bool evaluate(uint8_t, uint8_t, uint8_t&) const = 0;
 };
 
 #endif
@@ -14,8 +14,13 @@ void BitwiseAndNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void BitwiseAndNode::generate(BrainfuckWriter& writer)
+IrOpcode BitwiseAndNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::AND;
+}
+
+bool BitwiseAndNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs & rhs;
+    return true;
 }
@@ -13,8 +13,14 @@ void BitwiseLeftShiftNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void BitwiseLeftShiftNode::generate(BrainfuckWriter& writer)
+IrOpcode BitwiseLeftShiftNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::SHL;
+}
+
+bool BitwiseLeftShiftNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    //Every bit is shifted out of a u8 from 8 onwards
+    result = rhs >= 8 ? 0 : lhs << rhs;
+    return true;
 }
@@ -10,7 +10,8 @@ class BitwiseLeftShiftNode : public BinaryOperatorNode
         virtual ~BitwiseLeftShiftNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrOpcode getOpcode() const;
+        virtual bool evaluate(uint8_t, uint8_t, uint8_t&) const;
 };
 
 #endif
@@ -14,8 +14,13 @@ void BitwiseOrNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void BitwiseOrNode::generate(BrainfuckWriter& writer)
+IrOpcode BitwiseOrNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::OR;
+}
+
+bool BitwiseOrNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs | rhs;
+    return true;
 }
@@ -14,8 +14,13 @@ void BitwiseRightShiftNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void BitwiseRightShiftNode::generate(BrainfuckWriter& writer)
+IrOpcode BitwiseRightShiftNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::SHR;
+}
+
+bool BitwiseRightShiftNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = rhs >= 8 ? 0 : lhs >> rhs;
+    return true;
 }
@@ -14,8 +14,13 @@ void BitwiseXorNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void BitwiseXorNode::generate(BrainfuckWriter& writer)
+IrOpcode BitwiseXorNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::XOR;
+}
+
+bool BitwiseXorNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs ^ rhs;
+    return true;
 }
@@ -13,8 +13,13 @@ void ComplementNode::print(std::ostream& os, size_t level) const
     this->op->print(os, level+1);
 }
 
-void ComplementNode::generate(BrainfuckWriter& writer)
+IrOpcode ComplementNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::NOT;
+}
+
+bool ComplementNode::evaluate(uint8_t value, uint8_t& result) const
+{
+    result = ~value;
+    return true;
 }
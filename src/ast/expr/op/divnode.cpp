@@ -14,8 +14,16 @@ void DivNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void DivNode::generate(BrainfuckWriter& writer)
+IrOpcode DivNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::DIV;
+}
+
+bool DivNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    //Division by zero is left for the program to run into
+    if(rhs == 0)
+        return false;
+    result = lhs / rhs;
+    return true;
 }
@@ -14,8 +14,15 @@ void ModNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void ModNode::generate(BrainfuckWriter& writer)
+IrOpcode ModNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::MOD;
+}
+
+bool ModNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    if(rhs == 0)
+        return false;
+    result = lhs % rhs;
+    return true;
 }
@@ -14,10 +14,13 @@ void MulNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void MulNode::generate(BrainfuckWriter& writer)
+IrOpcode MulNode::getOpcode() const
 {
-    if(this->type->equals(DataType<DataTypeClass::U8>()))
-        writer.mulU8();
-    else
-        writer.unimplemented();
+    return IrOpcode::MUL;
+}
+
+bool MulNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs * rhs;
+    return true;
 }
@@ -13,8 +13,13 @@ void NegateNode::print(std::ostream& os, size_t level) const
     this->op->print(os, level+1);
 }
 
-void NegateNode::generate(BrainfuckWriter& writer)
+IrOpcode NegateNode::getOpcode() const
 {
-    ///TODO
-    writer.unimplemented();
+    return IrOpcode::NEG;
+}
+
+bool NegateNode::evaluate(uint8_t value, uint8_t& result) const
+{
+    result = -value;
+    return true;
 }
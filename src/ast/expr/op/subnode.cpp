@@ -14,10 +14,13 @@ void SubNode::print(std::ostream& os, size_t level) const
     this->rop->print(os, level+1);
 }
 
-void SubNode::generate(BrainfuckWriter& writer)
+IrOpcode SubNode::getOpcode() const
 {
-    if(this->type->equals(DataType<DataTypeClass::U8>()))
-        writer.subU8();
-    else
-        writer.unimplemented();
+    return IrOpcode::SUB;
+}
+
+bool SubNode::evaluate(uint8_t lhs, uint8_t rhs, uint8_t& result) const
+{
+    result = lhs - rhs;
+    return true;
 }
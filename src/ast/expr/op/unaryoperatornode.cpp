@@ -1,23 +1,20 @@
 #include "ast/expr/op/unaryoperatornode.h"
+#include "ast/expr/u8constantnode.h"
+#include "common/arena.h"
 #include "except/exceptions.h"
+#include "ir/builder.h"
 
 #include <sstream>
 #include <memory>
 
 UnaryOperatorNode::UnaryOperatorNode(ExpressionNode* op)
-    : op(op) {}
-
-UnaryOperatorNode::~UnaryOperatorNode()
-{
-    delete this->op;
-    delete this->type;
-}
+    : op(op), type(nullptr) {}
 
 void UnaryOperatorNode::checkTypes(BrainfuckWriter& writer)
 {
     this->op->checkTypes(writer);
 
-    std::unique_ptr<DataTypeBase> op_type(this->op->getType());
+    const DataTypeBase* op_type = this->op->getType();
     if(!op_type->supportsArithmetic())
     {
         std::stringstream ss;
@@ -25,15 +22,32 @@ void UnaryOperatorNode::checkTypes(BrainfuckWriter& writer)
         ss << *op_type;
         throw TypeMismatchException(ss.str());
     }
-    this->type = op_type.release();
+    this->type = op_type;
+}
+
+IrValue UnaryOperatorNode::lower(IrBuilder& builder)
+{
+    IrValue value = this->op->lower(builder);
+    return builder.unary(this->getOpcode(), this->type, value);
 }
 
-DataTypeBase* UnaryOperatorNode::getType()
+const DataTypeBase* UnaryOperatorNode::getType()
 {
-    return this->type->copy();
+    return this->type;
 }
 
-void UnaryOperatorNode::declareLocals(BrainfuckWriter& writer)
+void UnaryOperatorNode::foldConstants(Arena& arena)
 {
-    this->op->declareLocals(writer);
+    this->op = this->op->fold(arena);
+}
+
+ExpressionNode* UnaryOperatorNode::fold(Arena& arena)
+{
+    this->foldConstants(arena);
+
+    U8ConstantNode* operand = dynamic_cast<U8ConstantNode*>(this->op);
+    uint8_t result;
+    if(operand != nullptr && this->evaluate(operand->getValue(), result))
+        return arena.create<U8ConstantNode>(result);
+    return this;
 }
@@ -1,21 +1,30 @@
 #ifndef SRC_AST_EXPR_OP_UNARYEXPRESSIONNODE_H_
 #define SRC_AST_EXPR_OP_UNARYEXPRESSIONNODE_H_
 
+#include <cstdint>
 #include "ast/expr/expressionnode.h"
 
 class UnaryOperatorNode : public ExpressionNode
 {
     protected:
         ExpressionNode* op;
-        DataTypeBase* type;
+        const DataTypeBase* type;
 
         UnaryOperatorNode(ExpressionNode*);
     public:
-        virtual ~UnaryOperatorNode();
+        virtual ~UnaryOperatorNode() = default;
 
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+        virtual void foldConstants(Arena&);
+        virtual ExpressionNode* fold(Arena&);
+        virtual IrValue lower(IrBuilder&);
+
+        virtual IrOpcode getOpcode() const = 0;
+
+        //Computes the operation on a u8 value, wrapping modulo 256.
+        //Returns false if the result can't be known at compile time.
+        virtual bool evaluate(uint8_t, uint8_t&) const = 0;
 };
 
 #endif
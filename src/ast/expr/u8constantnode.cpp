@@ -1,6 +1,7 @@
 #include "ast/expr/u8constantnode.h"
 #include "generator/brainfuck.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
@@ -15,9 +16,9 @@ void U8ConstantNode::print(std::ostream& os, size_t level) const
     os << "u8 constant (" << (size_t)this->value << ")" << std::endl;
 }
 
-void U8ConstantNode::generate(BrainfuckWriter& writer)
+IrValue U8ConstantNode::lower(IrBuilder& builder)
 {
-    writer.pushByte(this->value);
+    return builder.constant(TypeTable::get<DataTypeClass::U8>(), this->value);
 }
 
 void U8ConstantNode::checkTypes(BrainfuckWriter& writer)
@@ -25,12 +26,12 @@ void U8ConstantNode::checkTypes(BrainfuckWriter& writer)
     UNUSED(writer);
 }
 
-DataTypeBase* U8ConstantNode::getType()
+const DataTypeBase* U8ConstantNode::getType()
 {
-    return new DataType<DataTypeClass::U8>();
+    return TypeTable::get<DataTypeClass::U8>();
 }
 
-void U8ConstantNode::declareLocals(BrainfuckWriter& writer)
+uint8_t U8ConstantNode::getValue() const
 {
-    UNUSED(writer);
+    return this->value;
 }
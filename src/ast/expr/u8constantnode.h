@@ -13,10 +13,11 @@ class U8ConstantNode : public ExpressionNode
         virtual ~U8ConstantNode();
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
+
+        uint8_t getValue() const;
 };
 
 #endif
@@ -2,18 +2,14 @@
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
-#include <memory>
+#include <optional>
 #include <sstream>
 
-VariableNode::VariableNode(const std::string& variable):
-    variable(variable), datatype(nullptr) {}
-
-VariableNode::~VariableNode()
-{
-    delete this->datatype;
-}
+VariableNode::VariableNode(Symbol variable):
+    variable(variable), datatype(nullptr), slot(nullptr) {}
 
 void VariableNode::print(std::ostream& os, size_t level) const
 {
@@ -21,17 +17,20 @@ void VariableNode::print(std::ostream& os, size_t level) const
     os << "variable (" << this->variable << ")" << std::endl;
 }
 
-void VariableNode::generate(BrainfuckWriter& writer)
+IrValue VariableNode::lower(IrBuilder& builder)
 {
-    std::unique_ptr<VariableDefinition> variable(writer.getDeclaredVariable(this->variable));
-    std::unique_ptr<DataTypeBase> datatype(variable->dataType());
-    writer.loadValue(variable->location(), datatype->size(writer));
+    return builder.load(this->datatype, this->slot);
+}
+
+void VariableNode::lowerStore(IrBuilder& builder, IrValue value)
+{
+    builder.store(this->datatype, this->slot, value);
 }
 
 void VariableNode::checkTypes(BrainfuckWriter& writer)
 {
-    std::unique_ptr<VariableDefinition> variable(writer.getDeclaredVariable(this->variable));
-    if(variable == nullptr)
+    std::optional<VariableDefinition> variable = writer.getDeclaredVariable(this->variable);
+    if(!variable)
     {
         std::stringstream ss;
         ss << "Use of undeclared variable " << this->variable;
@@ -39,14 +38,11 @@ void VariableNode::checkTypes(BrainfuckWriter& writer)
     }
 
     this->datatype = variable->dataType();
+    this->slot = variable->slot();
+    writer.useVariable(this->slot);
 }
 
-DataTypeBase* VariableNode::getType()
+const DataTypeBase* VariableNode::getType()
 {
     return this->datatype;
 }
-
-void VariableNode::declareLocals(BrainfuckWriter& writer)
-{
-    UNUSED(writer);
-}
@@ -1,25 +1,26 @@
 #ifndef SRC_AST_EXPR_VARIABLENODE_H_
 #define SRC_AST_EXPR_VARIABLENODE_H_
 
-#include <string>
 #include "ast/expr/expressionnode.h"
+#include "generator/variableslot.h"
 
 class VariableNode : public ExpressionNode
 {
     private:
-        std::string variable;
-        DataTypeBase* datatype;
+        Symbol variable;
+        const DataTypeBase* datatype;
+        const VariableSlot* slot;
     public:
-        VariableNode(const std::string&);
-        virtual ~VariableNode();
+        VariableNode(Symbol);
+        virtual ~VariableNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual IrValue lower(IrBuilder&);
+        virtual void lowerStore(IrBuilder&, IrValue);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual DataTypeBase* getType();
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual const DataTypeBase* getType();
 
-        std::string getName();
+        Symbol getName();
 };
 
 #endif
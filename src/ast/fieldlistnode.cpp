@@ -25,8 +25,3 @@ void FieldListNode::checkTypes(BrainfuckWriter& writer)
 {
     UNUSED(writer);
 }
-
-void FieldListNode::generate(BrainfuckWriter& writer)
-{
-    UNUSED(writer);
-}
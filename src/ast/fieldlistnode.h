@@ -13,7 +13,6 @@ class FieldListNode : public Node
         virtual ~FieldListNode();
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
 
         std::vector<Field>& getParameters();
@@ -2,18 +2,12 @@
 #include "types/datatype.h"
 #include "generator/brainfuck.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
-FunctionDeclaration::FunctionDeclaration(const std::string& name, FieldListNode* parameters, DataTypeBase* return_type, BlockNode* content):
-    name(name), parameters(parameters), return_type(return_type), content(content) {}
-
-FunctionDeclaration::~FunctionDeclaration()
-{
-    delete this->content;
-    delete this->return_type;
-    delete this->parameters;
-}
+FunctionDeclaration::FunctionDeclaration(Symbol name, FieldListNode* parameters, const DataTypeBase* return_type, BlockNode* content):
+    name(name), parameters(parameters), return_type(return_type), content(content), scope(0), frame_size(0) {}
 
 void FunctionDeclaration::print(std::ostream& output, size_t level) const
 {
@@ -35,6 +29,7 @@ void FunctionDeclaration::checkTypes(BrainfuckWriter& writer)
 {
     size_t old_scope = writer.getScope();
     writer.switchScope(this->scope);
+    writer.enterFrame();
 
     this->parameters->checkTypes(writer);
     for(Field& field : this->parameters->getParameters())
@@ -42,10 +37,23 @@ void FunctionDeclaration::checkTypes(BrainfuckWriter& writer)
 
     this->content->checkTypes(writer);
 
+    writer.exitFrame();
+    this->frame_size = writer.allocateFrame();
     writer.switchScope(old_scope);
 }
 
-void FunctionDeclaration::generate(BrainfuckWriter& writer)
+void FunctionDeclaration::lower(IrBuilder& builder)
+{
+    size_t old_function = builder.getFunction();
+    builder.switchFunction(this->scope);
+    builder.defineFunction(this->name, this->frame_size);
+
+    this->content->lower(builder);
+
+    builder.switchFunction(old_function);
+}
+
+void FunctionDeclaration::foldConstants(Arena& arena)
 {
-    UNUSED(writer);
+    this->content->foldConstants(arena);
 }
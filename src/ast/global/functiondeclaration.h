@@ -8,19 +8,22 @@
 class FunctionDeclaration : public GlobalElementNode
 {
     private:
-        std::string name;
+        Symbol name;
         FieldListNode* parameters;
-        DataTypeBase* return_type;
+        const DataTypeBase* return_type;
         BlockNode* content;
         size_t scope;
+        //Cells for the parameters and locals, laid out once the body is checked
+        size_t frame_size;
     public:
-        FunctionDeclaration(const std::string&, FieldListNode*, DataTypeBase*, BlockNode*);
-        virtual ~FunctionDeclaration();
+        FunctionDeclaration(Symbol, FieldListNode*, const DataTypeBase*, BlockNode*);
+        virtual ~FunctionDeclaration() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
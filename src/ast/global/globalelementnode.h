@@ -7,6 +7,8 @@ class GlobalElementNode : public Node
 {
     public:
         virtual ~GlobalElementNode() = default;
+
+        virtual void lower(IrBuilder&) = 0;
 };
 
 #endif
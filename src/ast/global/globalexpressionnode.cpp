@@ -2,16 +2,13 @@
 #include "types/datatype.h"
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
 #include <sstream>
 
 GlobalExpressionNode::GlobalExpressionNode(ExpressionNode* expression) : expression(expression) {}
-GlobalExpressionNode::~GlobalExpressionNode()
-{
-    delete this->expression;
-}
 
 void GlobalExpressionNode::print(std::ostream& os, size_t size) const
 {
@@ -30,10 +27,13 @@ void GlobalExpressionNode::checkTypes(BrainfuckWriter& writer)
     this->expression->checkTypes(writer);
 }
 
-void GlobalExpressionNode::generate(BrainfuckWriter& writer)
+void GlobalExpressionNode::lower(IrBuilder& builder)
 {
-    std::unique_ptr<DataTypeBase> datatype(this->expression->getType());
+    //The value is dropped by not using it
+    this->expression->lower(builder);
+}
 
-    this->expression->generate(writer);
-    writer.pop(datatype.get());
+void GlobalExpressionNode::foldConstants(Arena& arena)
+{
+    this->expression = this->expression->fold(arena);
 }
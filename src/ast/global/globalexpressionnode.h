@@ -10,12 +10,13 @@ class GlobalExpressionNode : public GlobalElementNode
         ExpressionNode* expression;
     public:
         GlobalExpressionNode(ExpressionNode*);
-        virtual ~GlobalExpressionNode();
+        virtual ~GlobalExpressionNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -1,17 +1,12 @@
 #include "ast/global/globalnode.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
 GlobalNode::GlobalNode(const std::vector<GlobalElementNode*>& elements):
     elements(elements) {}
 
-GlobalNode::~GlobalNode()
-{
-    for(auto& it : this->elements)
-        delete it;
-}
-
 void GlobalNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -38,13 +33,19 @@ void GlobalNode::checkTypes(BrainfuckWriter& writer)
     writer.switchScope(GLOBAL_SCOPE);
 
     for(auto& it : this->elements)
-        it->declareGlobals(writer);
+        it->checkTypes(writer);
 
     writer.switchScope(old_scope);
 }
 
-void GlobalNode::generate(BrainfuckWriter& writer)
+void GlobalNode::lower(IrBuilder& builder)
 {
     for(auto& x : this->elements)
-        x->generate(writer);
+        x->lower(builder);
+}
+
+void GlobalNode::foldConstants(Arena& arena)
+{
+    for(auto& it : this->elements)
+        it->foldConstants(arena);
 }
@@ -9,12 +9,13 @@ class GlobalNode : public Node
         std::vector<GlobalElementNode*> elements;
     public:
         GlobalNode(const std::vector<GlobalElementNode*>&);
-        virtual ~GlobalNode();
+        virtual ~GlobalNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -3,17 +3,12 @@
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
-StructureDefinitionNode::StructureDefinitionNode(const std::string& name, FieldListNode* members):
-    name(name), members(members), type(new DataType<DataTypeClass::STRUCT_FORWARD>(name)) {}
-
-StructureDefinitionNode::~StructureDefinitionNode()
-{
-    delete this->type;
-    delete this->members;
-}
+StructureDefinitionNode::StructureDefinitionNode(Symbol name, FieldListNode* members):
+    name(name), members(members), type(TypeTable::getStructure(name)) {}
 
 void StructureDefinitionNode::print(std::ostream& os, size_t level) const
 {
@@ -37,12 +32,12 @@ void StructureDefinitionNode::checkTypes(BrainfuckWriter& writer)
 
     for(auto& it : this->members->getParameters())
     {
-        if(it.getType()->equals(*this->type))
-            throw RecursiveTypeException("Structure " + this->name + " contains itself in member " + it.getName());
+        if(it.getType() == this->type)
+            throw RecursiveTypeException("Structure " + this->name.str() + " contains itself in member " + it.getName().str());
     }
 }
 
-void StructureDefinitionNode::generate(BrainfuckWriter& writer)
+void StructureDefinitionNode::lower(IrBuilder& builder)
 {
-    UNUSED(writer);
+    UNUSED(builder);
 }
@@ -15,3 +15,8 @@ void Node::declareGlobals(BrainfuckWriter& writer)
 {
     UNUSED(writer);
 }
+
+void Node::foldConstants(Arena& arena)
+{
+    UNUSED(arena);
+}
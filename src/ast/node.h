@@ -6,10 +6,15 @@
 #include <vector>
 #include <map>
 #include "types/datatype.h"
+#include "ir/ir.h"
 
 class BrainfuckWriter;
+class IrBuilder;
+class Arena;
 class DataTypeBase;
 
+//Nodes are allocated from the Arena of the compilation unit, which outlives
+//them; they refer to their children but don't own them
 class Node
 {
     protected:
@@ -18,9 +23,11 @@ class Node
         virtual ~Node() = default;
 
         virtual void print(std::ostream&, size_t) const = 0;
-        virtual void generate(BrainfuckWriter&) = 0;
         virtual void declareGlobals(BrainfuckWriter&);
         virtual void checkTypes(BrainfuckWriter&) = 0;
+
+        //Replaces constant subexpressions by their value
+        virtual void foldConstants(Arena&);
 };
 
 #endif
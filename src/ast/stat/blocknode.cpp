@@ -1,17 +1,13 @@
 #include "ast/stat/blocknode.h"
 #include "generator/brainfuck.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
 BlockNode::BlockNode(StatementNode* content):
     content(content) {}
 
-BlockNode::~BlockNode()
-{
-    delete this->content;
-}
-
 void BlockNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -26,19 +22,13 @@ void BlockNode::checkTypes(BrainfuckWriter& writer)
     writer.exitFrame();
 }
 
-void BlockNode::generate(BrainfuckWriter& writer)
+void BlockNode::lower(IrBuilder& builder)
 {
-    writer.enterFrame();
-    this->content->declareLocals(writer);
-
-    writer.makeStackFrame();
-    this->content->generate(writer);
-    writer.destroyStackFrame();
-
-    writer.exitFrame();
+    //Locals live in the frame of the function
+    this->content->lower(builder);
 }
 
-void BlockNode::declareLocals(BrainfuckWriter& writer)
+void BlockNode::foldConstants(Arena& arena)
 {
-    UNUSED(writer);
+    this->content->foldConstants(arena);
 }
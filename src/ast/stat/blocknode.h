@@ -9,12 +9,12 @@ class BlockNode : public StatementNode
         StatementNode* content;
     public:
         BlockNode(StatementNode*);
-        virtual ~BlockNode();
+        virtual ~BlockNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
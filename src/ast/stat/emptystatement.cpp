@@ -1,5 +1,6 @@
 #include "ast/stat/emptystatement.h"
 #include "common/util.h"
+#include "ir/builder.h"
 
 #include <iostream>
 
@@ -16,12 +17,7 @@ void EmptyStatementNode::checkTypes(BrainfuckWriter& writer)
     UNUSED(writer);
 }
 
-void EmptyStatementNode::generate(BrainfuckWriter& writer)
+void EmptyStatementNode::lower(IrBuilder& builder)
 {
-    UNUSED(writer);
-}
-
-void EmptyStatementNode::declareLocals(BrainfuckWriter& writer)
-{
-    UNUSED(writer);
+    UNUSED(builder);
 }
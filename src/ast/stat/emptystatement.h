@@ -10,9 +10,8 @@ class EmptyStatementNode : public StatementNode
         virtual ~EmptyStatementNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
 };
 
 #endif
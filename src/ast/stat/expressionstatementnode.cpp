@@ -1,5 +1,6 @@
 #include "ast/stat/expressionstatementnode.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
@@ -7,11 +8,6 @@
 ExpressionStatementNode::ExpressionStatementNode(ExpressionNode* node):
     content(node) {}
 
-ExpressionStatementNode::~ExpressionStatementNode()
-{
-    delete this->content;
-}
-
 void ExpressionStatementNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -24,14 +20,13 @@ void ExpressionStatementNode::checkTypes(BrainfuckWriter& writer)
     this->content->checkTypes(writer);
 }
 
-void ExpressionStatementNode::generate(BrainfuckWriter& writer)
+void ExpressionStatementNode::lower(IrBuilder& builder)
 {
-    this->content->generate(writer);
-    std::unique_ptr<DataTypeBase> datatype(this->content->getType());
-    writer.pop(datatype.get());
+    //The value is dropped by not using it
+    this->content->lower(builder);
 }
 
-void ExpressionStatementNode::declareLocals(BrainfuckWriter& writer)
+void ExpressionStatementNode::foldConstants(Arena& arena)
 {
-    this->content->declareLocals(writer);
+    this->content = this->content->fold(arena);
 }
@@ -10,12 +10,12 @@ class ExpressionStatementNode : public StatementNode
         ExpressionNode* content;
     public:
         ExpressionStatementNode(ExpressionNode*);
-        virtual ~ExpressionStatementNode();
+        virtual ~ExpressionStatementNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
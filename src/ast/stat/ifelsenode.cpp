@@ -1,6 +1,7 @@
 #include "ast/stat/ifelsenode.h"
 #include "except/exceptions.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
@@ -8,13 +9,6 @@
 IfElseNode::IfElseNode(ExpressionNode* conditional, StatementNode* statement, StatementNode* else_statement):
     conditional(conditional), statement(statement), else_statement(else_statement) {}
 
-IfElseNode::~IfElseNode()
-{
-    delete this->conditional;
-    delete this->statement;
-    delete this->else_statement;
-}
-
 void IfElseNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -30,20 +24,33 @@ void IfElseNode::checkTypes(BrainfuckWriter& writer)
     this->statement->checkTypes(writer);
     this->else_statement->checkTypes(writer);
 
-    std::unique_ptr<DataTypeBase> cond_type(this->conditional->getType());
+    const DataTypeBase* cond_type = this->conditional->getType();
     if(!cond_type->isBoolean())
         throw TypeMismatchException("Conditional for if-else statement was not convertable to boolean");
 }
 
-void IfElseNode::generate(BrainfuckWriter& writer)
+void IfElseNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    IrValue condition = this->conditional->lower(builder);
+    IrBlockId taken = builder.createBlock();
+    IrBlockId not_taken = builder.createBlock();
+    IrBlockId merge = builder.createBlock();
+    builder.branch(condition, taken, not_taken, merge);
+
+    builder.setBlock(taken);
+    this->statement->lower(builder);
+    builder.jump(merge);
+
+    builder.setBlock(not_taken);
+    this->else_statement->lower(builder);
+    builder.jump(merge);
+
+    builder.setBlock(merge);
 }
 
-void IfElseNode::declareLocals(BrainfuckWriter& writer)
+void IfElseNode::foldConstants(Arena& arena)
 {
-    this->conditional->declareLocals(writer);
-    this->statement->declareLocals(writer);
-    this->else_statement->declareLocals(writer);
+    this->conditional = this->conditional->fold(arena);
+    this->statement->foldConstants(arena);
+    this->else_statement->foldConstants(arena);
 }
@@ -12,12 +12,12 @@ class IfElseNode : public StatementNode
         StatementNode* else_statement;
     public:
         IfElseNode(ExpressionNode*, StatementNode*, StatementNode*);
-        virtual ~IfElseNode();
+        virtual ~IfElseNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -1,6 +1,7 @@
 #include "ast/stat/ifnode.h"
 #include "except/exceptions.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
@@ -8,12 +9,6 @@
 IfNode::IfNode(ExpressionNode* conditional, StatementNode* statement):
     conditional(conditional), statement(statement) {}
 
-IfNode::~IfNode()
-{
-    delete this->conditional;
-    delete this->statement;
-}
-
 void IfNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -27,19 +22,27 @@ void IfNode::checkTypes(BrainfuckWriter& writer)
     this->conditional->checkTypes(writer);
     this->statement->checkTypes(writer);
 
-    std::unique_ptr<DataTypeBase> cond_type(this->conditional->getType());
+    const DataTypeBase* cond_type = this->conditional->getType();
     if(!cond_type->isBoolean())
         throw TypeMismatchException("Conditional for if statement was not convertable to boolean");
 }
 
-void IfNode::generate(BrainfuckWriter& writer)
+void IfNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    IrValue condition = this->conditional->lower(builder);
+    IrBlockId taken = builder.createBlock();
+    IrBlockId merge = builder.createBlock();
+    builder.branch(condition, taken, merge, merge);
+
+    builder.setBlock(taken);
+    this->statement->lower(builder);
+    builder.jump(merge);
+
+    builder.setBlock(merge);
 }
 
-void IfNode::declareLocals(BrainfuckWriter& writer)
+void IfNode::foldConstants(Arena& arena)
 {
-    this->conditional->declareLocals(writer);
-    this->statement->declareLocals(writer);
+    this->conditional = this->conditional->fold(arena);
+    this->statement->foldConstants(arena);
 }
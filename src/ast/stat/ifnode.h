@@ -11,12 +11,12 @@ class IfNode : public StatementNode
         StatementNode* statement;
     public:
         IfNode(ExpressionNode*, StatementNode*);
-        virtual ~IfNode();
+        virtual ~IfNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
@@ -1,6 +1,8 @@
 #include "ast/stat/returnnode.h"
 #include "except/exceptions.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
+#include "common/util.h"
 
 #include <iostream>
 #include <memory>
@@ -9,11 +11,6 @@
 ReturnNode::ReturnNode(ExpressionNode* retval):
     retval(retval) {}
 
-ReturnNode::~ReturnNode()
-{
-    delete this->retval;
-}
-
 void ReturnNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -29,11 +26,11 @@ void ReturnNode::checkTypes(BrainfuckWriter& writer)
 
     size_t current_scope = writer.getScope();
     FunctionDefinition* definition = writer.lookupScope(current_scope);
-    std::unique_ptr<DataTypeBase> func_rettype(definition->getReturnType());
+    const DataTypeBase* func_rettype = definition->getReturnType();
 
-    std::unique_ptr<DataTypeBase> return_type(this->retval == nullptr ? new DataType<DataTypeClass::VOID>() : this->retval->getType());
+    const DataTypeBase* return_type = this->retval == nullptr ? TypeTable::get<DataTypeClass::VOID>() : this->retval->getType();
 
-    if(!return_type->equals(*func_rettype.get()))
+    if(return_type != func_rettype)
     {
         std::stringstream ss;
         ss << "Return with expression of type " << *return_type <<
@@ -42,13 +39,15 @@ void ReturnNode::checkTypes(BrainfuckWriter& writer)
     }
 }
 
-void ReturnNode::generate(BrainfuckWriter& writer)
+void ReturnNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    ///TODO: lower once the backend generates function bodies
+    UNUSED(builder);
+    throw UnsupportedException("Returning from functions is not supported yet, function bodies aren't generated");
 }
 
-void ReturnNode::declareLocals(BrainfuckWriter& writer)
+void ReturnNode::foldConstants(Arena& arena)
 {
-    this->retval->declareLocals(writer);
+    if(this->retval != nullptr)
+        this->retval = this->retval->fold(arena);
 }
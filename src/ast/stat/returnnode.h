@@ -10,12 +10,12 @@ class ReturnNode : public StatementNode
         ExpressionNode* retval;
     public:
         ReturnNode(ExpressionNode*);
-        virtual ~ReturnNode();
+        virtual ~ReturnNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
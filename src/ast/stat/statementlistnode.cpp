@@ -1,35 +1,30 @@
 #include "ast/stat/statementlistnode.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
-StatementListNode::StatementListNode(StatementNode* first, StatementNode* second):
-    first(first), second(second) {}
-
-StatementListNode::~StatementListNode()
-{
-    delete this->first;
-    delete this->second;
-}
+StatementListNode::StatementListNode(const std::vector<StatementNode*>& statements):
+    statements(statements) {}
 
 void StatementListNode::print(std::ostream& os, size_t level) const
 {
-    this->first->print(os, level);
-    this->second->print(os, level);
+    for(auto& it : this->statements)
+        it->print(os, level);
 }
 
 void StatementListNode::checkTypes(BrainfuckWriter& writer)
 {
-    this->first->checkTypes(writer);
-    this->second->checkTypes(writer);
+    for(auto& it : this->statements)
+        it->checkTypes(writer);
 }
 
-void StatementListNode::generate(BrainfuckWriter& writer)
+void StatementListNode::lower(IrBuilder& builder)
 {
-    this->first->generate(writer);
-    this->second->generate(writer);
+    for(auto& it : this->statements)
+        it->lower(builder);
 }
 
-void StatementListNode::declareLocals(BrainfuckWriter& writer)
+void StatementListNode::foldConstants(Arena& arena)
 {
-    this->first->declareLocals(writer);
-    this->second->declareLocals(writer);
+    for(auto& it : this->statements)
+        it->foldConstants(arena);
 }
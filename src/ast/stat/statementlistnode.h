@@ -1,21 +1,21 @@
 #ifndef SRC_AST_STAT_STATEMENTLISTNODE_H_
 #define SRC_AST_STAT_STATEMENTLISTNODE_H_
 
+#include <vector>
 #include "ast/stat/statementnode.h"
 
 class StatementListNode : public StatementNode
 {
     private:
-        StatementNode* first;
-        StatementNode* second;
+        std::vector<StatementNode*> statements;
     public:
-        StatementListNode(StatementNode*, StatementNode*);
-        virtual ~StatementListNode();
+        StatementListNode(const std::vector<StatementNode*>&);
+        virtual ~StatementListNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
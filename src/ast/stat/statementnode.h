@@ -8,7 +8,7 @@ class StatementNode : public Node
     public:
         virtual ~StatementNode() = default;
 
-        virtual void declareLocals(BrainfuckWriter&) = 0;
+        virtual void lower(IrBuilder&) = 0;
 };
 
 #endif
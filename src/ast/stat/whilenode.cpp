@@ -1,6 +1,7 @@
 #include "ast/stat/whilenode.h"
 #include "except/exceptions.h"
 #include "generator/brainfuck.h"
+#include "ir/builder.h"
 
 #include <iostream>
 #include <memory>
@@ -8,12 +9,6 @@
 WhileNode::WhileNode(ExpressionNode* conditional, StatementNode* statement):
     conditional(conditional), statement(statement) {}
 
-WhileNode::~WhileNode()
-{
-    delete this->conditional;
-    delete this->statement;
-}
-
 void WhileNode::print(std::ostream& os, size_t level) const
 {
     this->printIndent(os, level);
@@ -24,22 +19,36 @@ void WhileNode::print(std::ostream& os, size_t level) const
 
 void WhileNode::checkTypes(BrainfuckWriter& writer)
 {
+    writer.enterLoop();
     this->conditional->checkTypes(writer);
     this->statement->checkTypes(writer);
+    writer.exitLoop();
 
-    std::unique_ptr<DataTypeBase> cond_type(this->conditional->getType());
+    const DataTypeBase* cond_type = this->conditional->getType();
     if(!cond_type->isBoolean())
         throw TypeMismatchException("Cannot convert conditional in while-loop to a boolean");
 }
 
-void WhileNode::generate(BrainfuckWriter& writer)
+void WhileNode::lower(IrBuilder& builder)
 {
-    ///TODO
-    writer.unimplemented();
+    IrBlockId header = builder.createBlock();
+    IrBlockId body = builder.createBlock();
+    IrBlockId exit = builder.createBlock();
+    builder.jump(header);
+
+    builder.setBlock(header);
+    IrValue condition = this->conditional->lower(builder);
+    builder.loop(condition, body, exit);
+
+    builder.setBlock(body);
+    this->statement->lower(builder);
+    builder.jump(header);
+
+    builder.setBlock(exit);
 }
 
-void WhileNode::declareLocals(BrainfuckWriter& writer)
+void WhileNode::foldConstants(Arena& arena)
 {
-    this->conditional->declareLocals(writer);
-    this->statement->declareLocals(writer);
+    this->conditional = this->conditional->fold(arena);
+    this->statement->foldConstants(arena);
 }
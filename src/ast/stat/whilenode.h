@@ -11,12 +11,12 @@ class WhileNode : public StatementNode
         StatementNode* statement;
     public:
         WhileNode(ExpressionNode*, StatementNode*);
-        virtual ~WhileNode();
+        virtual ~WhileNode() = default;
 
         virtual void print(std::ostream&, size_t) const;
-        virtual void generate(BrainfuckWriter&);
+        virtual void lower(IrBuilder&);
         virtual void checkTypes(BrainfuckWriter&);
-        virtual void declareLocals(BrainfuckWriter&);
+        virtual void foldConstants(Arena&);
 };
 
 #endif
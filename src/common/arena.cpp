@@ -0,0 +1,37 @@
+#include "common/arena.h"
+
+#include <cstdint>
+
+Arena::Arena():
+    destructors(nullptr), current(nullptr), remaining(0), allocated(0) {}
+
+Arena::~Arena()
+{
+    for(Destructor* it = this->destructors; it != nullptr; it = it->next)
+        it->destroy(it);
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = -(uintptr_t)this->current & (alignment - 1);
+    if(padding + size > this->remaining)
+    {
+        //Oversized objects get a block of their own
+        size_t block_size = size + alignment > ARENA_BLOCK_SIZE ? size + alignment : ARENA_BLOCK_SIZE;
+        this->blocks.emplace_back(new char[block_size]);
+        this->current = this->blocks.back().get();
+        this->remaining = block_size;
+        padding = -(uintptr_t)this->current & (alignment - 1);
+    }
+
+    void* memory = this->current + padding;
+    this->current += padding + size;
+    this->remaining -= padding + size;
+    this->allocated += size;
+    return memory;
+}
+
+size_t Arena::getAllocatedBytes() const
+{
+    return this->allocated;
+}
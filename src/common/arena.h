@@ -0,0 +1,69 @@
+#ifndef SRC_COMMON_ARENA_H_
+#define SRC_COMMON_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Size of the blocks an Arena carves its objects out of
+const size_t ARENA_BLOCK_SIZE = 1 << 16;
+
+//Bump pointer allocator that owns everything created through it. Destructors
+//of objects that need one are run in reverse order of creation when the arena
+//itself is destroyed, so objects may freely point at each other.
+class Arena
+{
+    private:
+        //Placed right in front of the object it destroys, newest first
+        struct alignas(std::max_align_t) Destructor
+        {
+            Destructor* next;
+            void (*destroy)(Destructor*);
+        };
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        Destructor* destructors;
+        char* current;
+        size_t remaining;
+        size_t allocated;
+
+        void* allocate(size_t, size_t);
+    public:
+        Arena();
+        Arena(const Arena&) = delete;
+        ~Arena();
+
+        Arena& operator=(const Arena&) = delete;
+
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            if constexpr (std::is_trivially_destructible_v<T>)
+                return new(this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            else
+            {
+                static_assert(alignof(T) <= alignof(Destructor), "Over-aligned types can't be allocated from an arena");
+
+                void* memory = this->allocate(sizeof(Destructor) + sizeof(T), alignof(Destructor));
+                Destructor* record = static_cast<Destructor*>(memory);
+                T* object = new(record + 1) T(std::forward<Args>(args)...);
+
+                //Only linked once constructed, a throwing constructor leaves nothing to destroy
+                record->next = this->destructors;
+                record->destroy = [](Destructor* record)
+                {
+                    reinterpret_cast<T*>(record + 1)->~T();
+                };
+                this->destructors = record;
+                return object;
+            }
+        }
+
+        //Number of bytes handed out, excluding alignment padding
+        size_t getAllocatedBytes() const;
+};
+
+#endif
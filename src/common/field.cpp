@@ -1,29 +1,21 @@
 #include "common/field.h"
 
-Field::Field(DataTypeBase* type, const std::string& name):
+Field::Field(const DataTypeBase* type, Symbol name):
     type(type), name(name) {}
 
-Field::Field(const Field& other):
-    type(other.type->copy()), name(other.name) {}
-
-Field::~Field()
-{
-    delete this->type;
-}
-
 const DataTypeBase* Field::getType() const
 {
     return this->type;
 }
 
-const std::string& Field::getName() const
+Symbol Field::getName() const
 {
     return this->name;
 }
 
 Field* Field::copy() const
 {
-    return new Field(this->type->copy(), this->name);
+    return new Field(this->type, this->name);
 }
 
 std::ostream& operator<<(std::ostream& os, const Field& field)
@@ -3,21 +3,22 @@
 
 #include <ostream>
 #include "types/datatype.h"
+#include "common/symbol.h"
 
 class Field
 {
     private:
         const DataTypeBase* type;
-        const std::string name;
+        Symbol name;
 
         friend std::ostream& operator<<(std::ostream&, const Field&);
     public:
-        Field(DataTypeBase* type, const std::string& name);
-        Field(const Field& other);
-        ~Field();
+        Field(const DataTypeBase* type, Symbol name);
+        Field(const Field& other) = default;
+        ~Field() = default;
 
         const DataTypeBase* getType() const;
-        const std::string& getName() const;
+        Symbol getName() const;
 
         Field* copy() const;
 };
@@ -0,0 +1,41 @@
+#include "common/symbol.h"
+
+#include <deque>
+#include <unordered_map>
+
+struct SymbolTable
+{
+    //A deque never moves its elements, so the views in ids stay valid
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+static SymbolTable& symbolTable()
+{
+    static SymbolTable table;
+    return table;
+}
+
+Symbol Symbol::intern(std::string_view name)
+{
+    SymbolTable& table = symbolTable();
+    auto it = table.ids.find(name);
+    if(it != table.ids.end())
+        return Symbol(it->second);
+
+    uint32_t id = table.names.size();
+    table.names.emplace_back(name);
+    table.ids.emplace(table.names.back(), id);
+    return Symbol(id);
+}
+
+const std::string& Symbol::str() const
+{
+    return symbolTable().names[this->id];
+}
+
+std::ostream& operator<<(std::ostream& os, Symbol symbol)
+{
+    os << symbol.str();
+    return os;
+}
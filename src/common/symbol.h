@@ -0,0 +1,59 @@
+#ifndef SRC_COMMON_SYMBOL_H_
+#define SRC_COMMON_SYMBOL_H_
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+//Interned identifier. Every distinct name is stored once and numbered in order
+//of first appearance, so symbols compare, order and hash as plain integers.
+class Symbol
+{
+    private:
+        uint32_t id;
+
+        explicit Symbol(uint32_t id):
+            id(id) {}
+    public:
+        static Symbol intern(std::string_view);
+
+        const std::string& str() const;
+
+        uint32_t getId() const
+        {
+            return this->id;
+        }
+
+        bool operator==(Symbol other) const
+        {
+            return this->id == other.id;
+        }
+
+        bool operator!=(Symbol other) const
+        {
+            return this->id != other.id;
+        }
+
+        bool operator<(Symbol other) const
+        {
+            return this->id < other.id;
+        }
+};
+
+std::ostream& operator<<(std::ostream&, Symbol);
+
+namespace std
+{
+    template <>
+    struct hash<Symbol>
+    {
+        size_t operator()(Symbol symbol) const
+        {
+            return symbol.getId();
+        }
+    };
+}
+
+#endif
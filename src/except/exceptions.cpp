@@ -47,3 +47,15 @@ VariantException::VariantException(const std::string& msg):
 
 VariantException::VariantException(const char* msg):
     AlipheeseException(msg) {}
+
+UnsupportedException::UnsupportedException(const std::string& msg):
+    AlipheeseException(msg) {}
+
+UnsupportedException::UnsupportedException(const char* msg):
+    AlipheeseException(msg) {}
+
+RuntimeException::RuntimeException(const std::string& msg):
+    AlipheeseException(msg) {}
+
+RuntimeException::RuntimeException(const char* msg):
+    AlipheeseException(msg) {}
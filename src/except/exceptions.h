@@ -68,4 +68,21 @@ class VariantException : public AlipheeseException
         virtual ~VariantException() = default;
 };
 
+//Valid programs the compiler can't generate code for yet
+class UnsupportedException : public AlipheeseException
+{
+    public:
+        UnsupportedException(const std::string& msg);
+        UnsupportedException(const char* msg);
+        virtual ~UnsupportedException() = default;
+};
+
+class RuntimeException : public AlipheeseException
+{
+    public:
+        RuntimeException(const std::string& msg);
+        RuntimeException(const char* msg);
+        virtual ~RuntimeException() = default;
+};
+
 #endif
@@ -0,0 +1,710 @@
+#include "generator/backend.h"
+#include "generator/brainfuck.h"
+#include "types/datatype.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+static const IrBlockId NO_BLOCK = UINT32_MAX;
+
+BrainfuckBackend::BrainfuckBackend(BrainfuckWriter& writer):
+    writer(&writer), function(nullptr), stack_floor(0), frame_base(0) {}
+
+size_t BrainfuckBackend::size(IrValue value)
+{
+    return this->types[value]->size(*this->writer);
+}
+
+size_t BrainfuckBackend::locate(const VariableSlot& slot)
+{
+    //Globals sit at the bottom of the tape, below every frame
+    if(slot.global)
+        return slot.offset;
+    return this->frame_base + slot.offset;
+}
+
+size_t BrainfuckBackend::source(IrValue value)
+{
+    //Only a load that can be loaded again runs out of copies
+    if(this->copies[value] == 0)
+        return this->locate(*this->slots[value]);
+    return this->cells[value];
+}
+
+void BrainfuckBackend::countUses()
+{
+    const IrFunction& function = *this->function;
+    this->types.assign(function.value_count, nullptr);
+    this->uses.assign(function.value_count, 0);
+    this->remaining_uses.assign(function.value_count, 0);
+    this->copies.assign(function.value_count, 0);
+    this->cells.assign(function.value_count, 0);
+    this->slots.assign(function.value_count, nullptr);
+
+    for(const IrBlock& block : function.blocks)
+    {
+        for(const IrInstruction& instruction : block.instructions)
+        {
+            if(instruction.result != NO_VALUE)
+                this->types[instruction.result] = instruction.type;
+            if(instruction.opcode == IrOpcode::LOAD)
+                this->slots[instruction.result] = instruction.slot;
+            for(IrValue operand : instruction.operands)
+            {
+                if(operand != NO_VALUE)
+                    this->uses[operand]++;
+            }
+            if(instruction.opcode == IrOpcode::ASM)
+            {
+                for(IrValue argument : function.assembly[instruction.immediate].arguments)
+                    this->uses[argument]++;
+            }
+        }
+        if(block.terminator.value != NO_VALUE)
+            this->uses[block.terminator.value]++;
+    }
+}
+
+void BrainfuckBackend::pairDivisions()
+{
+    const DataTypeBase* u8 = TypeTable::get<DataTypeClass::U8>();
+    const IrFunction& function = *this->function;
+    //Equal constants are different values, so they are keyed by immediate
+    std::vector<uint64_t> keys(function.value_count);
+    for(IrValue value = 0; value < function.value_count; ++value)
+        keys[value] = value;
+    std::vector<bool> constant(function.value_count, false);
+    this->partners.assign(function.value_count, NO_VALUE);
+    this->paired.assign(function.value_count, false);
+
+    for(const IrBlock& block : function.blocks)
+    {
+        //Divisions and remainders waiting for a partner, by operands and opcode
+        std::unordered_map<uint64_t, IrValue> waiting;
+        for(const IrInstruction& instruction : block.instructions)
+        {
+            IrValue lhs = instruction.operands[0];
+            IrValue rhs = instruction.operands[1];
+            if(instruction.opcode == IrOpcode::CONSTANT && instruction.type == u8 && instruction.immediate < 256)
+            {
+                constant[instruction.result] = true;
+                keys[instruction.result] = function.value_count + instruction.immediate;
+            }
+            if((instruction.opcode != IrOpcode::DIV && instruction.opcode != IrOpcode::MOD) || instruction.type != u8)
+                continue;
+
+            bool division = instruction.opcode == IrOpcode::DIV;
+            uint64_t key = (keys[lhs] << 32 | keys[rhs]) << 1;
+            auto partner = waiting.find(key | !division);
+            if(partner == waiting.end())
+            {
+                waiting.emplace(key | division, instruction.result);
+                continue;
+            }
+
+            this->partners[partner->second] = instruction.result;
+            this->paired[instruction.result] = true;
+            waiting.erase(partner);
+            //The operands are taken by the partner, a constant nothing else
+            //uses isn't pushed at all
+            for(IrValue operand : instruction.operands)
+                this->uses[operand]--;
+        }
+    }
+}
+
+void BrainfuckBackend::planCopies()
+{
+    //A use finds its copy on top if the copy is the first operand, or either
+    //operand of a commutative operator, and every other value pushed since
+    //the previous use is gone, except the other operand. Planning stops at
+    //the first use that doesn't.
+    const IrFunction& function = *this->function;
+    std::vector<uint32_t> planned(function.value_count, 0);
+    std::vector<bool> planning(function.value_count, false);
+    std::vector<size_t> last_use(function.value_count, 0);
+    //Position of the last use of every value in its block
+    std::vector<size_t> end(function.value_count, 0);
+    std::vector<size_t> defined(function.value_count, 0);
+    this->reloadable.assign(function.value_count, false);
+    const std::vector<IrInstruction>* instructions = nullptr;
+
+    auto isBuried = [&](IrValue value, IrValue other, size_t position)
+    {
+        //Including the result of the previous use
+        for(size_t i = last_use[value]; i < position; ++i)
+        {
+            IrValue result = (*instructions)[i].result;
+            if(result != NO_VALUE && result != value && result != other && !this->folded[result] && !this->paired[result] && end[result] > position)
+                return true;
+            IrValue partner = result != NO_VALUE ? this->partners[result] : NO_VALUE;
+            if(partner != NO_VALUE && partner != other && end[partner] > position)
+                return true;
+        }
+        return false;
+    };
+    auto use = [&](IrValue value, IrValue other, bool first, size_t position)
+    {
+        if(!planning[value])
+            return;
+        if(first && (other == value || !isBuried(value, other, position)))
+        {
+            planned[value]++;
+            last_use[value] = position;
+        }
+        else
+        {
+            planning[value] = false;
+        }
+    };
+
+    for(const IrBlock& block : function.blocks)
+    {
+        instructions = &block.instructions;
+        //Position each cell was last stored to, and of the last call, which
+        //may store to any of them
+        std::unordered_map<size_t, size_t> stored;
+        size_t called = 0;
+        auto read = [&](IrValue value, size_t position)
+        {
+            end[value] = position;
+            if(!this->reloadable[value])
+                return;
+            size_t cell = this->locate(*this->slots[value]);
+            for(size_t i = cell; i < cell + this->size(value) && this->reloadable[value]; ++i)
+            {
+                auto store = stored.find(i);
+                this->reloadable[value] = store == stored.end() || store->second < defined[value];
+            }
+            this->reloadable[value] = this->reloadable[value] && called <= defined[value];
+        };
+
+        for(size_t i = 0; i < instructions->size(); ++i)
+        {
+            const IrInstruction& instruction = (*instructions)[i];
+            if(instruction.result != NO_VALUE && this->paired[instruction.result])
+                continue;
+            for(IrValue operand : instruction.operands)
+            {
+                if(operand != NO_VALUE)
+                    read(operand, i);
+            }
+            if(instruction.opcode == IrOpcode::ASM)
+            {
+                for(IrValue argument : function.assembly[instruction.immediate].arguments)
+                    read(argument, i);
+            }
+
+            if(instruction.opcode == IrOpcode::LOAD)
+            {
+                defined[instruction.result] = i;
+                this->reloadable[instruction.result] = true;
+            }
+            else if(instruction.opcode == IrOpcode::STORE)
+            {
+                size_t cell = this->locate(*instruction.slot);
+                for(size_t j = cell; j < cell + this->size(instruction.operands[0]); ++j)
+                    stored[j] = i;
+            }
+            else if(instruction.opcode == IrOpcode::UNIMPLEMENTED)
+            {
+                called = i + 1;
+            }
+        }
+        if(block.terminator.value != NO_VALUE)
+            read(block.terminator.value, instructions->size());
+
+        for(size_t i = 0; i < instructions->size(); ++i)
+        {
+            const IrInstruction& instruction = (*instructions)[i];
+            IrValue lhs = instruction.operands[0];
+            IrValue rhs = instruction.operands[1];
+            if(instruction.opcode == IrOpcode::ASM)
+            {
+                //Arguments are always copied
+                for(IrValue argument : function.assembly[instruction.immediate].arguments)
+                    planning[argument] = false;
+            }
+            else if(lhs != NO_VALUE && !(instruction.result != NO_VALUE && this->paired[instruction.result]))
+            {
+                use(lhs, rhs, true, i);
+                if(rhs != NO_VALUE)
+                    use(rhs, lhs, rhs == lhs || isCommutative(instruction.opcode), i);
+            }
+
+            if(instruction.result != NO_VALUE)
+            {
+                last_use[instruction.result] = i;
+                planning[instruction.result] = instruction.opcode == IrOpcode::LOAD && this->uses[instruction.result] > 1;
+            }
+        }
+        if(block.terminator.value != NO_VALUE)
+            use(block.terminator.value, NO_VALUE, true, instructions->size());
+    }
+
+    //One more copy is left to copy from for the uses after planning stopped
+    this->load_copies.assign(function.value_count, 1);
+    for(IrValue value = 0; value < function.value_count; ++value)
+    {
+        if(planned[value] > 0)
+            this->load_copies[value] = std::min(planned[value] + 1, this->uses[value]);
+    }
+}
+
+void BrainfuckBackend::foldFactors()
+{
+    const DataTypeBase* u8 = TypeTable::get<DataTypeClass::U8>();
+    const IrFunction& function = *this->function;
+    std::vector<bool> constant(function.value_count, false);
+    std::vector<uint64_t> immediates(function.value_count, 0);
+    this->folded.assign(function.value_count, false);
+    this->factors.assign(function.value_count, 0);
+    this->divisors.assign(function.value_count, false);
+
+    auto fold = [&](IrValue value, uint8_t factor)
+    {
+        this->folded[value] = true;
+        this->factors[value] = factor;
+    };
+    //Every bit is shifted out of a u8 from 8 onwards
+    auto power = [&](IrValue value)
+    {
+        return immediates[value] < 8 ? 1 << immediates[value] : 0;
+    };
+    auto foldable = [&](IrValue value)
+    {
+        return constant[value] && this->uses[value] == 1;
+    };
+
+    for(const IrBlock& block : function.blocks)
+    {
+        for(const IrInstruction& instruction : block.instructions)
+        {
+            IrValue lhs = instruction.operands[0];
+            IrValue rhs = instruction.operands[1];
+            if(instruction.opcode == IrOpcode::CONSTANT && instruction.type == u8)
+            {
+                constant[instruction.result] = true;
+                immediates[instruction.result] = instruction.immediate;
+            }
+            else if(instruction.opcode == IrOpcode::MUL && instruction.type == u8)
+            {
+                if(foldable(rhs))
+                    fold(rhs, immediates[rhs]);
+                else if(foldable(lhs))
+                    fold(lhs, immediates[lhs]);
+            }
+            else if(instruction.opcode == IrOpcode::SHL && instruction.type == u8 && foldable(rhs))
+            {
+                fold(rhs, power(rhs));
+            }
+            else if(instruction.opcode == IrOpcode::SHR && instruction.type == u8 && foldable(rhs))
+            {
+                //Dividing by 256 pushed as 0 gives 0 as well
+                this->divisors[rhs] = true;
+                this->factors[rhs] = power(rhs);
+            }
+        }
+    }
+}
+
+void BrainfuckBackend::define(IrValue value, size_t cell, size_t copies)
+{
+    this->cells[value] = cell;
+    this->remaining_uses[value] = this->uses[value];
+    this->copies[value] = copies;
+    for(size_t i = 0; i < copies; ++i)
+        this->stack.push_back(StackEntry{value, cell + i * this->size(value)});
+}
+
+void BrainfuckBackend::pop()
+{
+    if(this->stack.back().value != NO_VALUE)
+        this->copies[this->stack.back().value]--;
+    this->stack.pop_back();
+}
+
+void BrainfuckBackend::popDead()
+{
+    while(this->stack.size() > this->stack_floor &&
+          (this->stack.back().value == NO_VALUE || this->remaining_uses[this->stack.back().value] == 0))
+    {
+        this->writer->moveStackPointerTo(this->stack.back().cell);
+        this->pop();
+    }
+}
+
+bool BrainfuckBackend::isConsumable(IrValue value, uint32_t taken)
+{
+    return this->remaining_uses[value] - taken == 1 || this->copies[value] - taken >= 2 || this->reloadable[value];
+}
+
+size_t BrainfuckBackend::countInPlace(const IrValue* operands, size_t count)
+{
+    //Longest prefix of the operands that already is the top of the stack
+    size_t in_place = count;
+    for(; in_place > 0; --in_place)
+    {
+        if(this->stack.size() < this->stack_floor + in_place)
+            continue;
+
+        size_t first = this->stack.size() - in_place;
+        bool matches = true;
+        for(size_t i = 0; i < in_place && matches; ++i)
+        {
+            //Copies are consumed from the top, so the operands after this one go first
+            uint32_t taken = 0;
+            for(size_t j = i + 1; j < in_place; ++j)
+                taken += operands[j] == operands[i];
+            matches = this->stack[first + i].value == operands[i] && this->isConsumable(operands[i], taken);
+        }
+        if(matches)
+            break;
+    }
+    return in_place;
+}
+
+size_t BrainfuckBackend::takeOperands(const IrValue* operands, size_t count)
+{
+    size_t in_place = this->countInPlace(operands, count);
+
+    size_t base = in_place > 0 ? this->stack[this->stack.size() - in_place].cell : this->writer->getStackLocation();
+    for(size_t i = 0; i < in_place; ++i)
+    {
+        this->remaining_uses[this->stack.back().value]--;
+        this->pop();
+    }
+    //Copies of values that die here leave a hole until the result is gone
+    for(size_t i = in_place; i < count; ++i)
+    {
+        this->writer->loadValue(this->source(operands[i]), this->size(operands[i]));
+        this->remaining_uses[operands[i]]--;
+    }
+    return base;
+}
+
+void BrainfuckBackend::generate(const IrProgram& program)
+{
+    this->writer->reserveGlobals();
+    this->generate(program.functions[GLOBAL_SCOPE]);
+}
+
+void BrainfuckBackend::generate(const IrFunction& function)
+{
+    this->function = &function;
+    this->stack.clear();
+    this->stack_floor = 0;
+    //Locals are right above where the function starts, the stack above them
+    this->frame_base = this->writer->getStackLocation();
+    this->writer->incrementStackPointerBy(function.frame_size);
+    this->countUses();
+    this->pairDivisions();
+    this->foldFactors();
+    this->planCopies();
+    this->generateRegion(0, NO_BLOCK);
+}
+
+void BrainfuckBackend::generateRegion(IrBlockId block, IrBlockId end)
+{
+    while(block != end)
+    {
+        const IrBlock& current = this->function->blocks[block];
+        const IrTerminator& terminator = current.terminator;
+        if(terminator.kind == IrTerminatorKind::LOOP)
+        {
+            this->generateLoop(block);
+            block = terminator.targets[1];
+            continue;
+        }
+
+        this->generateInstructions(current);
+        switch(terminator.kind)
+        {
+            case IrTerminatorKind::JUMP:
+                block = terminator.targets[0];
+                break;
+            case IrTerminatorKind::BRANCH:
+                this->generateBranch(terminator);
+                block = terminator.merge;
+                break;
+            case IrTerminatorKind::RETURN:
+                //Only the global code is generated, which ends here without
+                //a value, return statements are rejected while lowering
+                return;
+            case IrTerminatorKind::LOOP:
+                break;
+        }
+    }
+}
+
+void BrainfuckBackend::generateInstructions(const IrBlock& block)
+{
+    for(const IrInstruction& instruction : block.instructions)
+    {
+        this->generateInstruction(instruction);
+        this->popDead();
+    }
+}
+
+void BrainfuckBackend::generateInstruction(const IrInstruction& instruction)
+{
+    const DataTypeBase* u8 = TypeTable::get<DataTypeClass::U8>();
+    size_t base = this->writer->getStackLocation();
+
+    switch(instruction.opcode)
+    {
+        case IrOpcode::CONSTANT:
+            if(this->folded[instruction.result] || this->uses[instruction.result] == 0)
+            {
+                return;
+            }
+            else if(instruction.type == u8)
+            {
+                this->writer->pushByte(this->divisors[instruction.result] ? this->factors[instruction.result] : instruction.immediate);
+            }
+            else
+            {
+                this->writer->unimplemented();
+                this->writer->push(instruction.type);
+            }
+            break;
+        case IrOpcode::LOAD:
+        {
+            size_t copies = this->load_copies[instruction.result];
+            this->writer->loadValue(this->locate(*instruction.slot), this->size(instruction.result), copies);
+            this->define(instruction.result, base, copies);
+            return;
+        }
+        case IrOpcode::STORE:
+            this->generateStore(instruction);
+            return;
+        case IrOpcode::ASM:
+            this->generateAssembly(instruction);
+            return;
+        case IrOpcode::UNIMPLEMENTED:
+            this->writer->unimplemented();
+            this->writer->push(instruction.type);
+            break;
+        default:
+        {
+            IrValue lhs = instruction.operands[0];
+            IrValue rhs = instruction.operands[1];
+            IrValue partner = this->partners[instruction.result];
+            if(this->paired[instruction.result])
+                return;
+            if(partner != NO_VALUE)
+            {
+                IrValue operands[2] = {lhs, rhs};
+                base = this->takeOperands(operands, 2);
+                this->writer->divModU8();
+                bool division = instruction.opcode == IrOpcode::DIV;
+                this->define(division ? instruction.result : partner, base, 1);
+                this->define(division ? partner : instruction.result, base + 1, 1);
+                return;
+            }
+            if(rhs != NO_VALUE && this->folded[rhs])
+            {
+                this->generateScale(instruction, lhs, this->factors[rhs]);
+                return;
+            }
+            if(this->folded[lhs])
+            {
+                this->generateScale(instruction, rhs, this->factors[lhs]);
+                return;
+            }
+
+            size_t count = rhs == NO_VALUE ? 1 : 2;
+            IrValue operands[2] = {lhs, rhs};
+            IrValue swapped[2] = {rhs, lhs};
+            if(count == 2 && isCommutative(instruction.opcode) &&
+               this->countInPlace(swapped, 2) > this->countInPlace(operands, 2))
+            {
+                base = this->takeOperands(swapped, 2);
+            }
+            else
+            {
+                base = this->takeOperands(operands, count);
+            }
+            if(instruction.type == u8 && instruction.opcode == IrOpcode::ADD)
+            {
+                this->writer->addU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::SUB)
+            {
+                this->writer->subU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::MUL)
+            {
+                this->writer->mulU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::DIV)
+            {
+                this->writer->divU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::MOD)
+            {
+                this->writer->modU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::SHL)
+            {
+                this->writer->shlU8();
+            }
+            else if(instruction.type == u8 && instruction.opcode == IrOpcode::SHR)
+            {
+                if(this->divisors[rhs])
+                    this->writer->divU8();
+                else
+                    this->writer->shrU8();
+            }
+            else
+            {
+                ///TODO
+                this->writer->unimplemented();
+                this->writer->moveStackPointerTo(base + this->size(instruction.result));
+            }
+            break;
+        }
+    }
+    this->define(instruction.result, base, 1);
+}
+
+void BrainfuckBackend::generateStore(const IrInstruction& instruction)
+{
+    IrValue value = instruction.operands[0];
+    size_t target = this->locate(*instruction.slot);
+    size_t size = this->size(value);
+
+    if(this->stack.size() > this->stack_floor && this->stack.back().value == value && this->isConsumable(value, 0))
+    {
+        size_t cell = this->stack.back().cell;
+        for(size_t i = 0; i < size; ++i)
+            this->writer->moveByte(cell + i, target + i);
+        this->pop();
+        this->writer->moveStackPointerTo(cell);
+    }
+    else
+    {
+        this->writer->copyValue(this->source(value), target, this->writer->getStackLocation(), size);
+    }
+    this->remaining_uses[value]--;
+}
+
+void BrainfuckBackend::generateScale(const IrInstruction& instruction, IrValue operand, uint8_t factor)
+{
+    size_t base = this->takeOperands(&operand, 1);
+    if(factor == 0)
+    {
+        this->writer->moveStackPointerTo(base);
+        this->writer->clearByte();
+        this->writer->incrementStackPointer();
+    }
+    else if(factor != 1)
+    {
+        //Scaling into the cell above takes a single loop, the zeroed operand
+        //stays below the product until it is popped
+        this->writer->incrementStackPointer();
+        this->writer->scaleByte(base, base + 1, factor);
+        this->stack.push_back(StackEntry{NO_VALUE, base});
+        base++;
+    }
+    this->define(instruction.result, base, 1);
+}
+
+void BrainfuckBackend::generateAssembly(const IrInstruction& instruction)
+{
+    const IrAssembly& assembly = this->function->assembly[instruction.immediate];
+
+    //Zero initialized return value
+    size_t base = this->writer->getStackLocation();
+    this->writer->push(instruction.type);
+    size_t top = this->writer->getStackLocation();
+    for(size_t cell = base; cell != top; ++cell)
+    {
+        this->writer->moveStackPointerTo(cell);
+        this->writer->clearByte();
+    }
+    this->writer->moveStackPointerTo(top);
+    this->define(instruction.result, base, 1);
+
+    //Arguments, right above the return value
+    for(IrValue argument : assembly.arguments)
+    {
+        this->writer->loadValue(this->source(argument), this->size(argument));
+        this->remaining_uses[argument]--;
+    }
+    this->writer->copyAssembly(*assembly.code);
+    //Argument cleanup
+    this->writer->moveStackPointerTo(top);
+}
+
+void BrainfuckBackend::generateBranch(const IrTerminator& terminator)
+{
+    //The condition is consumed as the flag of the then branch, an else branch
+    //gets a flag of its own that the then branch clears
+    size_t flag = this->takeOperands(&terminator.value, 1);
+    bool has_else = terminator.targets[1] != terminator.merge;
+    if(has_else)
+        this->writer->pushByte(1);
+    size_t top = this->writer->getStackLocation();
+
+    size_t old_floor = this->stack_floor;
+    this->stack_floor = this->stack.size();
+
+    this->writer->moveStackPointerTo(flag);
+    this->writer->branchOpen();
+    this->writer->clearByte();
+    if(has_else)
+    {
+        this->writer->moveStackPointerTo(flag + 1);
+        this->writer->clearByte();
+    }
+    this->writer->moveStackPointerTo(top);
+    this->generateRegion(terminator.targets[0], terminator.merge);
+    this->writer->moveStackPointerTo(flag);
+    this->writer->branchClose();
+
+    if(has_else)
+    {
+        this->writer->moveStackPointerTo(flag + 1);
+        this->writer->branchOpen();
+        this->writer->clearByte();
+        this->writer->moveStackPointerTo(top);
+        this->generateRegion(terminator.targets[1], terminator.merge);
+        this->writer->moveStackPointerTo(flag + 1);
+        this->writer->branchClose();
+    }
+
+    this->stack_floor = old_floor;
+    this->writer->moveStackPointerTo(flag);
+    this->popDead();
+}
+
+void BrainfuckBackend::generateLoop(IrBlockId header)
+{
+    const IrBlock& block = this->function->blocks[header];
+    const IrTerminator& terminator = block.terminator;
+
+    this->generateInstructions(block);
+    size_t flag = this->takeOperands(&terminator.value, 1);
+    size_t top = this->writer->getStackLocation();
+
+    size_t old_floor = this->stack_floor;
+    this->stack_floor = this->stack.size();
+
+    this->writer->moveStackPointerTo(flag);
+    this->writer->branchOpen();
+    this->writer->moveStackPointerTo(top);
+    this->generateRegion(terminator.targets[0], header);
+
+    //Evaluate the condition again, into the flag
+    this->generateInstructions(block);
+    size_t condition = this->takeOperands(&terminator.value, 1);
+    this->writer->moveByte(condition, flag);
+    this->writer->moveStackPointerTo(condition);
+    this->popDead();
+    this->writer->moveStackPointerTo(flag);
+    this->writer->branchClose();
+
+    this->stack_floor = old_floor;
+    this->popDead();
+}
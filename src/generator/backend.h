@@ -0,0 +1,104 @@
+#ifndef SRC_GENERATOR_BACKEND_H_
+#define SRC_GENERATOR_BACKEND_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "ir/ir.h"
+
+class BrainfuckWriter;
+
+//Lowers the IR to brainfuck through the writer. Every value is pushed onto
+//the stack where it is defined. Operands that are the topmost values and are
+//used for the last time are consumed in place, anything else is copied to
+//the top first, so code lowered from an expression tree evaluates exactly
+//like a stack machine. Values that die below a live one stay on the stack
+//until everything above them is gone. A variable loaded for several uses is
+//pushed several times by the same loop, one copy for each use expected to
+//find it on top of the stack, and one more to copy from for its other uses.
+//If the variable isn't written while the load is used, that copy may be
+//consumed early, and later uses load the variable again. Multiplying or
+//shifting left by a constant moves the other operand into the cell above it,
+//scaled in the same loop, and shifting right by a constant divides by its
+//power of two. A division and a remainder of the same operands in one block
+//are computed together, where the first of them is.
+class BrainfuckBackend
+{
+    private:
+        struct StackEntry
+        {
+            IrValue value;
+            size_t cell;
+        };
+
+        BrainfuckWriter* writer;
+        const IrFunction* function;
+
+        std::vector<const DataTypeBase*> types;
+        std::vector<uint32_t> uses;
+        //Copies pushed by each load
+        std::vector<uint32_t> load_copies;
+        //Variable of every load, and whether it isn't written while the load
+        //is used, so it can be loaded again once its copies are gone
+        std::vector<const VariableSlot*> slots;
+        std::vector<bool> reloadable;
+        //Uses left to generate of the values defined so far
+        std::vector<uint32_t> remaining_uses;
+        //Copies of every value on the stack, and the cell of the lowest one
+        std::vector<uint32_t> copies;
+        std::vector<size_t> cells;
+        //Constants folded into the operator that uses them instead of being
+        //pushed, with the factor they scale its other operand by
+        std::vector<bool> folded;
+        std::vector<uint8_t> factors;
+        //Constant amounts of right shifts, pushed as the power of two in
+        //factors to divide by
+        std::vector<bool> divisors;
+        //The other result of a division or remainder computed together with
+        //it, or NO_VALUE, and whether a result was computed by its partner
+        std::vector<IrValue> partners;
+        std::vector<bool> paired;
+        //Bottom first, cells left zero by an instruction are NO_VALUE
+        std::vector<StackEntry> stack;
+        //Values below this are owned by an enclosing branch or loop
+        size_t stack_floor;
+        //Cell the frame of the function being generated starts at
+        size_t frame_base;
+
+        size_t size(IrValue);
+        size_t locate(const VariableSlot&);
+        //Cell to copy a value from when it isn't on top
+        size_t source(IrValue);
+        void countUses();
+        void pairDivisions();
+        void planCopies();
+        void foldFactors();
+        void define(IrValue, size_t cell, size_t copies);
+        void pop();
+        void popDead();
+        //Whether the topmost copy of a value can be consumed in place, after
+        //the given number of its copies above it have been
+        bool isConsumable(IrValue, uint32_t taken);
+        size_t countInPlace(const IrValue*, size_t count);
+        //Puts the operands on top of the stack, in order, to be consumed.
+        //Returns the cell of the first one.
+        size_t takeOperands(const IrValue*, size_t count);
+
+        void generateRegion(IrBlockId, IrBlockId end);
+        void generateInstructions(const IrBlock&);
+        void generateInstruction(const IrInstruction&);
+        void generateStore(const IrInstruction&);
+        void generateScale(const IrInstruction&, IrValue operand, uint8_t factor);
+        void generateAssembly(const IrInstruction&);
+        void generateBranch(const IrTerminator&);
+        void generateLoop(IrBlockId);
+    public:
+        BrainfuckBackend(BrainfuckWriter&);
+
+        //Generates the code outside of functions, which is all that runs
+        //until functions can be called
+        void generate(const IrProgram&);
+        void generate(const IrFunction&);
+};
+
+#endif
@@ -1,73 +1,174 @@
 #include "generator/brainfuck.h"
 #include "except/exceptions.h"
 
+#include <array>
+#include <cstdlib>
 #include <memory>
+#include <ostream>
 
-Scope::Scope(Scope&& old):
-    declarations(old.declarations), stack_locations(old.stack_locations)
+//Recipe for producing a constant in a cleared cell. Without a counter the value
+//is reached by adjust alone, otherwise a loop first runs counter times over the
+//scratch cell right above, adding or subtracting factor on each pass.
+struct ByteConstant
 {
-}
+    size_t counter;
+    size_t factor;
+    bool subtract;
+    int adjust;
+    size_t cost;
+};
 
-void Scope::declareVariable(const std::string& name, const DataTypeBase* datatype)
+//Cheapest recipe for every byte value, in number of brainfuck instructions
+static const std::array<ByteConstant, 256>& byteConstants()
 {
-    std::map<std::string, const DataTypeBase*>& current_scope = this->declarations.back();
-    current_scope[name] = datatype;
+    static const std::array<ByteConstant, 256> table = []
+    {
+        std::array<ByteConstant, 256> constants;
+        for(int value = 0; value < 256; ++value)
+        {
+            //Plain increments, or decrements wrapping around from 0
+            if(value <= 128)
+                constants[value] = {0, 0, false, value, (size_t)value};
+            else
+                constants[value] = {0, 0, false, value - 256, (size_t)(256 - value)};
+        }
+
+        //">[-]" counter "[<" factor ">-]<" costs 10 instructions on top of counter and factor
+        std::array<ByteConstant, 256> loops;
+        for(auto& it : loops)
+            it.cost = SIZE_MAX;
+        for(size_t counter = 2; counter < 256; ++counter)
+        {
+            for(size_t factor = 2; factor < 256; ++factor)
+            {
+                size_t cost = counter + factor + 10;
+                if(cost >= 256)
+                    break;
+                uint8_t added = counter * factor;
+                uint8_t subtracted = -added;
+                if(cost < loops[added].cost)
+                    loops[added] = {counter, factor, false, 0, cost};
+                if(cost < loops[subtracted].cost)
+                    loops[subtracted] = {counter, factor, true, 0, cost};
+            }
+        }
+
+        for(int base = 0; base < 256; ++base)
+        {
+            if(loops[base].cost == SIZE_MAX)
+                continue;
+            for(int adjust = -128; adjust <= 128; ++adjust)
+            {
+                uint8_t value = base + adjust;
+                size_t cost = loops[base].cost + std::abs(adjust);
+                if(cost < constants[value].cost)
+                {
+                    constants[value] = loops[base];
+                    constants[value].adjust = adjust;
+                    constants[value].cost = cost;
+                }
+            }
+        }
+        return constants;
+    }();
+    return table;
+}
+
+Scope::Scope():
+    slots(16, Slot{EMPTY_SLOT, NO_BINDING}), used_slots(0) {}
+
+Scope::Slot* Scope::findSlot(Symbol name)
+{
+    size_t mask = this->slots.size() - 1;
+    for(size_t i = name.getId() & mask; ; i = (i + 1) & mask)
+    {
+        Slot& slot = this->slots[i];
+        if(slot.symbol == name.getId())
+            return &slot;
+        if(slot.symbol == EMPTY_SLOT)
+            return nullptr;
+    }
 }
 
-void Scope::setVariableLocation(const std::string& name, size_t location)
+Scope::Slot& Scope::insertSlot(Symbol name)
 {
-    std::map<std::string, size_t>& current_scope = this->stack_locations.back();
-    current_scope[name] = location;
-}
+    //Kept at most half full
+    if(2 * (this->used_slots + 1) > this->slots.size())
+        this->grow();
 
-const DataTypeBase* Scope::findVariable(const std::string& name)
-{
-    for(auto it = this->declarations.rbegin(); it != this->declarations.rend(); ++it)
+    size_t mask = this->slots.size() - 1;
+    size_t i = name.getId() & mask;
+    while(this->slots[i].symbol != name.getId() && this->slots[i].symbol != EMPTY_SLOT)
+        i = (i + 1) & mask;
+
+    if(this->slots[i].symbol == EMPTY_SLOT)
     {
-        auto found = it->find(name);
-        if(found != it->end())
-            return found->second;
+        this->slots[i] = Slot{name.getId(), NO_BINDING};
+        this->used_slots++;
     }
-    return nullptr;
+    return this->slots[i];
 }
 
-size_t Scope::findVariableLocation(const std::string& name)
+void Scope::grow()
 {
-    for(auto it = this->stack_locations.rbegin(); it != this->stack_locations.rend(); ++it)
+    std::vector<Slot> old_slots(2 * this->slots.size(), Slot{EMPTY_SLOT, NO_BINDING});
+    std::swap(old_slots, this->slots);
+
+    size_t mask = this->slots.size() - 1;
+    for(const Slot& slot : old_slots)
     {
-        auto found = it->find(name);
-        if(found != it->end())
-            return found->second;
+        if(slot.symbol == EMPTY_SLOT)
+            continue;
+        size_t i = slot.symbol & mask;
+        while(this->slots[i].symbol != EMPTY_SLOT)
+            i = (i + 1) & mask;
+        this->slots[i] = slot;
     }
-    return 0;
 }
 
-bool Scope::hasVariable(const std::string& name)
+VariableSlot* Scope::declareVariable(Symbol name, const DataTypeBase* datatype, const VariableSlot& variable_slot)
 {
-    return this->findVariable(name) != nullptr;
+    this->variable_slots.push_back(variable_slot);
+    Slot& slot = this->insertSlot(name);
+    this->bindings.push_back(Binding{name, datatype, &this->variable_slots.back(), slot.binding});
+    slot.binding = this->bindings.size() - 1;
+    return &this->variable_slots.back();
 }
 
-bool Scope::hasFrameVariable(const std::string& name)
+const Scope::Binding* Scope::findVariable(Symbol name)
 {
-    std::map<std::string, size_t>& current_scope = this->stack_locations.back();
-    return current_scope.find(name) != current_scope.end();
+    Slot* slot = this->findSlot(name);
+    if(slot == nullptr || slot->binding == NO_BINDING)
+        return nullptr;
+    return &this->bindings[slot->binding];
+}
+
+bool Scope::hasFrameVariable(Symbol name)
+{
+    Slot* slot = this->findSlot(name);
+    return slot != nullptr && slot->binding != NO_BINDING && slot->binding >= this->frames.back();
 }
 
 void Scope::enterFrame()
 {
-    this->declarations.emplace_back(std::map<std::string, const DataTypeBase*>());
-    this->stack_locations.emplace_back(std::map<std::string, size_t>());
+    this->frames.push_back(this->bindings.size());
 }
 
 void Scope::exitFrame()
 {
-    this->declarations.pop_back();
-    this->stack_locations.pop_back();
+    size_t start = this->frames.back();
+    while(this->bindings.size() > start)
+    {
+        const Binding& binding = this->bindings.back();
+        this->findSlot(binding.name)->binding = binding.shadowed;
+        this->bindings.pop_back();
+    }
+    this->frames.pop_back();
 }
 
-std::map<std::string, const DataTypeBase*>& Scope::getFrameDeclarations()
+CellAllocator& Scope::getAllocator()
 {
-    return this->declarations.back();
+    return this->allocator;
 }
 
 FunctionDefinition::FunctionDefinition(const std::vector<Field>& arguments, const DataTypeBase* return_type, BlockNode* code):
@@ -76,95 +177,133 @@ FunctionDefinition::FunctionDefinition(const std::vector<Field>& arguments, cons
 FunctionDefinition::FunctionDefinition(FunctionDefinition&& old):
     arguments(std::move(old.arguments)), return_type(old.return_type), code(old.code) {}
 
-bool FunctionDefinition::parametersEqual(const std::vector<DataTypeBase*>& arguments)
+bool FunctionDefinition::parametersEqual(const std::vector<const DataTypeBase*>& arguments)
+{
+    if(arguments.size() != this->arguments.size())
+        return false;
+    for(size_t i = 0; i < this->arguments.size(); ++i)
+    {
+        if(this->arguments[i].getType() != arguments[i])
+            return false;
+    }
+    return true;
+}
+
+bool FunctionDefinition::parametersEqual(const std::vector<Field>& arguments)
 {
     if(arguments.size() != this->arguments.size())
         return false;
     for(size_t i = 0; i < this->arguments.size(); ++i)
     {
-        if(!this->arguments[i].getType()->equals(*arguments[i]))
+        if(this->arguments[i].getType() != arguments[i].getType())
             return false;
     }
     return true;
 }
 
-DataTypeBase* FunctionDefinition::getReturnType() const
+const DataTypeBase* FunctionDefinition::getReturnType() const
 {
-    return this->return_type->copy();
+    return this->return_type;
 }
 
 StructureDefinition::StructureDefinition(const std::vector<Field>& fields):
-    fields(fields) {}
+    cached_size(0), size_known(false), fields(fields) {}
 
 StructureDefinition::StructureDefinition(StructureDefinition&& old):
-    fields(std::move(old.fields)) {}
+    cached_size(old.cached_size), size_known(old.size_known), fields(std::move(old.fields)) {}
 
 size_t StructureDefinition::size(BrainfuckWriter& writer) const
 {
+    if(this->size_known)
+        return this->cached_size;
+
     size_t total_size = 0;
     for(const Field& field : this->fields)
     {
         total_size += field.getType()->size(writer);
     }
+    this->cached_size = total_size;
+    this->size_known = true;
     return total_size;
 }
 
-VariableDefinition::VariableDefinition(const DataTypeBase* datatype, size_t location) : datatype(datatype), stack_location(location) {}
+VariableDefinition::VariableDefinition(const DataTypeBase* datatype, const VariableSlot* slot) : datatype(datatype), variable_slot(slot) {}
 
-DataTypeBase* VariableDefinition::dataType() const
+const DataTypeBase* VariableDefinition::dataType() const
 {
-    return this->datatype->copy();
+    return this->datatype;
 }
 
-size_t VariableDefinition::location() const
+const VariableSlot* VariableDefinition::slot() const
 {
-    return this->stack_location;
+    return this->variable_slot;
 }
 
 BrainfuckWriter::BrainfuckWriter(std::ostream& os):
-    output(&os), current_scope(GLOBAL_SCOPE), stack_pointer(0)
+    output(&os), current_scope(GLOBAL_SCOPE), stack_pointer(0), globals_size(0), frame_statistics{0, 0}, search_layout(false)
 {
     //Create the global scope, which always has exactly one frame
     Scope global_scope;
     global_scope.enterFrame();
     this->scopes.emplace_back(std::move(global_scope));
     this->scope_func_lookup.emplace_back(nullptr);
+    this->buffer.reserve(OUTPUT_CHUNK_SIZE);
 }
 
-size_t BrainfuckWriter::declareFunction(const std::string& name, const std::vector<Field>& arguments, const DataTypeBase* return_value, BlockNode* block_node)
+BrainfuckWriter::~BrainfuckWriter()
+{
+    this->flush();
+}
+
+size_t BrainfuckWriter::declareFunction(Symbol name, const std::vector<Field>& arguments, const DataTypeBase* return_value, BlockNode* block_node)
 {
     if(this->isFunctionDeclared(name, arguments))
-        throw RedefinitionException("Redefinition of function " + name);
+        throw RedefinitionException("Redefinition of function " + name.str());
     auto it = this->functions.emplace(name, FunctionDefinition(arguments, return_value, block_node));
     this->scopes.emplace_back(Scope());
     this->scope_func_lookup.emplace_back(&it->second);
     return this->scopes.size() - 1;
 }
 
-void BrainfuckWriter::declareStructure(const std::string& name, const std::vector<Field>& members)
+void BrainfuckWriter::declareStructure(Symbol name, const std::vector<Field>& members)
 {
     if(this->isStructureDeclared(name))
-        throw RedefinitionException("Redefinition of structure " + name);
+        throw RedefinitionException("Redefinition of structure " + name.str());
     this->structures.emplace(name, StructureDefinition(members));
 }
 
-void BrainfuckWriter::declareVariable(const std::string& name, const DataTypeBase* datatype)
+const VariableSlot* BrainfuckWriter::declareVariable(Symbol name, const DataTypeBase* datatype)
 {
     Scope& current_scope = this->scopes[this->current_scope];
     if(current_scope.hasFrameVariable(name))
-        throw RedefinitionException("Redefinition of variable " + name);
-    current_scope.declareVariable(name, datatype);
+        throw RedefinitionException("Redefinition of variable " + name.str());
+
+    size_t size = datatype->size(*this);
+    if(this->current_scope == GLOBAL_SCOPE)
+    {
+        VariableSlot* slot = current_scope.declareVariable(name, datatype, VariableSlot{true, this->globals_size, 0});
+        this->globals_size += size;
+        return slot;
+    }
+
+    VariableSlot* slot = current_scope.declareVariable(name, datatype, VariableSlot{false, 0, 0});
+    current_scope.getAllocator().declare(slot, size);
+    return slot;
 }
 
-bool BrainfuckWriter::isFunctionDeclared(const std::string& name, const std::vector<Field>& arguments)
+bool BrainfuckWriter::isFunctionDeclared(Symbol name, const std::vector<Field>& arguments)
 {
-    std::vector<const DataTypeBase*> argument_types;
-    for(auto& it : arguments)
-        argument_types.push_back(it.getType());
-    return this->isFunctionDeclared(name, arguments);
+    auto equal_range = this->functions.equal_range(name);
+
+    for(auto& it = equal_range.first; it != equal_range.second; ++it)
+    {
+        if(it->second.parametersEqual(arguments))
+            return true;
+    }
+    return false;
 }
 
-bool BrainfuckWriter::isFunctionDeclared(const std::string& name, const std::vector<DataTypeBase*>& arguments)
+bool BrainfuckWriter::isFunctionDeclared(Symbol name, const std::vector<const DataTypeBase*>& arguments)
 {
     auto equal_range = this->functions.equal_range(name);
 
@@ -176,12 +315,12 @@ bool BrainfuckWriter::isFunctionDeclared(const std::string& name, const std::vec
     return false;
 }
 
-bool BrainfuckWriter::isStructureDeclared(const std::string& name)
+bool BrainfuckWriter::isStructureDeclared(Symbol name)
 {
     return this->structures.find(name) != this->structures.end();
 }
 
-FunctionDefinition* BrainfuckWriter::getDeclaredFunction(const std::string& name, const std::vector<DataTypeBase*>& arguments)
+FunctionDefinition* BrainfuckWriter::getDeclaredFunction(Symbol name, const std::vector<const DataTypeBase*>& arguments)
 {
     auto equal_range = this->functions.equal_range(name);
 
@@ -193,7 +332,7 @@ FunctionDefinition* BrainfuckWriter::getDeclaredFunction(const std::string& name
     return nullptr;
 }
 
-StructureDefinition* BrainfuckWriter::getDeclaredStructure(const std::string& name)
+StructureDefinition* BrainfuckWriter::getDeclaredStructure(Symbol name)
 {
     auto it = this->structures.find(name);
     if(it != this->structures.end())
@@ -201,19 +340,15 @@ StructureDefinition* BrainfuckWriter::getDeclaredStructure(const std::string& na
     return nullptr;
 }
 
-VariableDefinition* BrainfuckWriter::getDeclaredVariable(const std::string& variable)
+std::optional<VariableDefinition> BrainfuckWriter::getDeclaredVariable(Symbol variable)
 {
-    const DataTypeBase* datatype = this->scopes[this->current_scope].findVariable(variable);
-    size_t location = this->scopes[this->current_scope].findVariableLocation(variable);
-    if(datatype == nullptr)
-    {
-        datatype = this->scopes[GLOBAL_SCOPE].findVariable(variable);
-        location = this->scopes[GLOBAL_SCOPE].findVariableLocation(variable);
-    }
+    const Scope::Binding* binding = this->scopes[this->current_scope].findVariable(variable);
+    if(binding == nullptr)
+        binding = this->scopes[GLOBAL_SCOPE].findVariable(variable);
 
-    if(datatype == nullptr)
-        return nullptr;
-    return new VariableDefinition(datatype, location);
+    if(binding == nullptr)
+        return std::nullopt;
+    return VariableDefinition(binding->datatype, binding->slot);
 }
 
 void BrainfuckWriter::switchScope(size_t new_scope)
@@ -243,18 +378,71 @@ void BrainfuckWriter::exitFrame()
     current_scope.exitFrame();
 }
 
+void BrainfuckWriter::useVariable(const VariableSlot* slot)
+{
+    if(!slot->global)
+        this->scopes[this->current_scope].getAllocator().use(*slot);
+}
+
+void BrainfuckWriter::enterLoop()
+{
+    this->scopes[this->current_scope].getAllocator().enterLoop();
+}
+
+void BrainfuckWriter::exitLoop()
+{
+    this->scopes[this->current_scope].getAllocator().exitLoop();
+}
+
+size_t BrainfuckWriter::allocateFrame()
+{
+    return this->scopes[this->current_scope].getAllocator().allocate(this->frame_statistics, this->search_layout);
+}
+
+void BrainfuckWriter::setLayoutSearch(bool search_layout)
+{
+    this->search_layout = search_layout;
+}
+
+const FrameStatistics& BrainfuckWriter::getFrameStatistics() const
+{
+    return this->frame_statistics;
+}
+
 std::ostream& BrainfuckWriter::getOutput()
 {
+    this->flush();
     return *this->output;
 }
 
 std::ostream& BrainfuckWriter::setOutput(std::ostream& output)
 {
+    this->flush();
     std::ostream* result = this->output;
     this->output = &output;
     return *result;
 }
 
+void BrainfuckWriter::flush()
+{
+    this->output->write(this->buffer.data(), this->buffer.size());
+    this->buffer.clear();
+}
+
+void BrainfuckWriter::emit(char c)
+{
+    this->buffer.push_back(c);
+    if(this->buffer.size() >= OUTPUT_CHUNK_SIZE)
+        this->flush();
+}
+
+void BrainfuckWriter::emit(size_t count, char c)
+{
+    this->buffer.append(count, c);
+    if(this->buffer.size() >= OUTPUT_CHUNK_SIZE)
+        this->flush();
+}
+
 size_t BrainfuckWriter::getStackLocation()
 {
     return this->stack_pointer;
@@ -262,73 +450,70 @@ size_t BrainfuckWriter::getStackLocation()
 
 void BrainfuckWriter::copyAssembly(const std::string& code)
 {
-    std::ostream& output = this->getOutput();
     for(char c : code)
     {
         //Keep track of the branch operations
         if(c == '[')
             this->branchOpen();
-        else if(c == '>')
+        else if(c == ']')
             this->branchClose();
         else
-            output << c;
+            this->emit(c);
     }
 }
 
 void BrainfuckWriter::increment()
 {
-    this->getOutput() << "+";
+    this->emit('+');
 }
 
 void BrainfuckWriter::decrement()
 {
-    this->getOutput() << "-";
+    this->emit('-');
 }
 
 void BrainfuckWriter::incrementBy(size_t num)
 {
-    for(size_t i = 0; i < num; ++i)
-        this->increment();
+    this->emit(num, '+');
 }
 
 void BrainfuckWriter::decrementBy(size_t num)
 {
-    for(size_t i = 0; i < num; ++i)
-        this->decrement();
+    this->emit(num, '-');
 }
 
 void BrainfuckWriter::incrementStackPointer()
 {
-    this->getOutput() << ">";
+    this->emit('>');
     ++this->stack_pointer;
 }
 
 void BrainfuckWriter::decrementStackPointer()
 {
-    this->getOutput() << "<";
+    this->emit('<');
     --this->stack_pointer;
 }
 
 void BrainfuckWriter::branchOpen()
 {
-    this->getOutput() << "[";
+    this->emit('[');
 }
 
 void BrainfuckWriter::branchClose()
 {
-    this->getOutput() << "]";
+    this->emit(']');
 }
 
 void BrainfuckWriter::incrementStackPointerBy(size_t num)
 {
-    for(size_t i = 0; i < num; ++i)
-        this->incrementStackPointer();
+    this->emit(num, '>');
+    this->stack_pointer += num;
 }
 
 void BrainfuckWriter::decrementStackPointerBy(size_t num)
 {
-    for(size_t i = 0; i < num; ++i)
-        this->decrementStackPointer();
+    this->emit(num, '<');
+    this->stack_pointer -= num;
 }
 
 void BrainfuckWriter::moveStackPointerTo(size_t index)
@@ -339,23 +524,9 @@ void BrainfuckWriter::moveStackPointerTo(size_t index)
         this->incrementStackPointerBy(index - this->stack_pointer);
 }
 
-void BrainfuckWriter::makeStackFrame()
+void BrainfuckWriter::reserveGlobals()
 {
-    std::map<std::string, const DataTypeBase*>& variables = this->scopes[this->current_scope].getFrameDeclarations();
-    for(auto& it : variables)
-    {
-        this->scopes[this->current_scope].setVariableLocation(it.first, this->stack_pointer);
-        this->push(it.second);
-    }
-}
-
-void BrainfuckWriter::destroyStackFrame()
-{
-    std::map<std::string, const DataTypeBase*>& variables = this->scopes[this->current_scope].getFrameDeclarations();
-    for(auto& it : variables)
-    {
-        this->pop(it.second);
-    }
+    this->incrementStackPointerBy(this->globals_size);
 }
 
 void BrainfuckWriter::push(const DataTypeBase* datatype)
@@ -370,8 +541,34 @@ void BrainfuckWriter::pop(const DataTypeBase* datatype)
 
 void BrainfuckWriter::pushByte(uint8_t value)
 {
+    const ByteConstant& constant = byteConstants()[value];
+
     this->clearByte();
-    this->incrementBy(value);
+    if(constant.counter != 0)
+    {
+        //Cells above the stack pointer may still hold popped values
+        this->incrementStackPointer();
+        this->clearByte();
+        this->incrementBy(constant.counter);
+        this->branchOpen();
+        this->decrementStackPointer();
+        if(constant.subtract)
+            this->decrementBy(constant.factor);
+        else
+            this->incrementBy(constant.factor);
+        this->incrementStackPointer();
+        this->decrement();
+        this->branchClose();
+        //The scratch cell is where the stack pointer ends up anyway
+        if(constant.adjust == 0)
+            return;
+        this->decrementStackPointer();
+    }
+    if(constant.adjust >= 0)
+        this->incrementBy(constant.adjust);
+    else
+        this->decrementBy(-constant.adjust);
+    this->incrementStackPointer();
 }
 
 void BrainfuckWriter::clearByte()
@@ -381,20 +578,73 @@ void BrainfuckWriter::clearByte()
     this->branchClose();
 }
 
-void BrainfuckWriter::copyByte(size_t from, size_t to, size_t temp)
+void BrainfuckWriter::moveByte(size_t from, size_t to)
 {
     size_t old_stack_pointer = this->stack_pointer;
 
-    this->moveStackPointerTo(temp);
+    this->moveStackPointerTo(to);
     this->clearByte();
 
+    this->moveStackPointerTo(from);
+    this->branchOpen();
+    this->moveStackPointerTo(to);
+    this->increment();
+    this->moveStackPointerTo(from);
+    this->decrement();
+    this->branchClose();
+
+    //Restore stack pointer
+    this->moveStackPointerTo(old_stack_pointer);
+}
+
+void BrainfuckWriter::scaleByte(size_t from, size_t to, uint8_t factor)
+{
+    size_t old_stack_pointer = this->stack_pointer;
+
     this->moveStackPointerTo(to);
     this->clearByte();
 
     this->moveStackPointerTo(from);
     this->branchOpen();
     this->moveStackPointerTo(to);
-    this->increment();
+    //Cells wrap around, so large factors are shorter subtracted
+    if(factor <= 128)
+        this->incrementBy(factor);
+    else
+        this->decrementBy(256 - factor);
+    this->moveStackPointerTo(from);
+    this->decrement();
+    this->branchClose();
+
+    //Restore stack pointer
+    this->moveStackPointerTo(old_stack_pointer);
+}
+
+void BrainfuckWriter::copyByte(size_t from, size_t to, size_t temp)
+{
+    this->spreadByte(from, to, 1, 1, temp);
+}
+
+void BrainfuckWriter::spreadByte(size_t from, size_t to, size_t stride, size_t copies, size_t temp)
+{
+    size_t old_stack_pointer = this->stack_pointer;
+
+    this->moveStackPointerTo(temp);
+    this->clearByte();
+
+    for(size_t i = 0; i < copies; ++i)
+    {
+        this->moveStackPointerTo(to + i * stride);
+        this->clearByte();
+    }
+
+    this->moveStackPointerTo(from);
+    this->branchOpen();
+    for(size_t i = 0; i < copies; ++i)
+    {
+        this->moveStackPointerTo(to + i * stride);
+        this->increment();
+    }
     this->moveStackPointerTo(temp);
     this->increment();
     this->moveStackPointerTo(from);
@@ -420,12 +670,18 @@ void BrainfuckWriter::copyValue(size_t from, size_t to, size_t temp, size_t size
 }
 
 void BrainfuckWriter::loadValue(size_t from, size_t size)
+{
+    this->loadValue(from, size, 1);
+}
+
+void BrainfuckWriter::loadValue(size_t from, size_t size, size_t copies)
 {
     size_t variable_start = this->stack_pointer;
-    this->incrementStackPointerBy(size);
+    this->incrementStackPointerBy(size * copies);
     size_t temporary_start = this->stack_pointer;
     this->incrementStackPointerBy(size);
-    this->copyValue(from, variable_start, temporary_start, size);
+    for(size_t i = 0; i < size; ++i)
+        this->spreadByte(from + i, variable_start + i, size, copies, temporary_start + i);
 
     //Clean up temporary storage
     this->decrementStackPointerBy(size);
@@ -447,7 +703,7 @@ void BrainfuckWriter::addU8()
     this->moveStackPointerTo(y);
     this->branchOpen();
     this->moveStackPointerTo(x);
-    this->decrement();
+    this->increment();
     this->moveStackPointerTo(temp);
     this->increment();
     this->moveStackPointerTo(y);
@@ -485,7 +741,7 @@ void BrainfuckWriter::subU8()
     this->moveStackPointerTo(y);
     this->branchOpen();
     this->moveStackPointerTo(x);
-    this->increment();
+    this->decrement();
     this->moveStackPointerTo(temp);
     this->increment();
     this->moveStackPointerTo(y);
@@ -513,39 +769,46 @@ void BrainfuckWriter::mulU8()
     size_t x = this->stack_pointer - 2;
     size_t y = this->stack_pointer - 1;
     size_t temp = this->stack_pointer;
-    size_t temp2 = this->stack_pointer + 1;
-    size_t temp3 = this->stack_pointer + 2;
-    size_t temp4 = this->stack_pointer + 3;
+    size_t counter = this->stack_pointer + 1;
 
     //Multiply(x, y) {
-    //    temp = y
-    //    temp2 = x
+    //    counter = x
     //    x = 0
-    //    while(temp) {
-    //        x += temp2
-    //        --temp;
+    //    while(counter) {
+    //        x += y, using temp to restore y
+    //        --counter
     //    }
     //}
 
-    //temp = y
-    this->loadValue(y, 1);
-    //temp2 = x
-    this->loadValue(x, 1);
-    //x = 0
-    this->moveStackPointerTo(x);
+    //Create temporary storage
+    this->moveStackPointerTo(temp);
     this->clearByte();
-    //while(temp) {
+    this->moveByte(x, counter);
+
+    //while(counter) {
+    this->moveStackPointerTo(counter);
+    this->branchOpen();
+    //x += y
+    this->moveStackPointerTo(y);
+    this->branchOpen();
+    this->moveStackPointerTo(x);
+    this->increment();
+    this->moveStackPointerTo(temp);
+    this->increment();
+    this->moveStackPointerTo(y);
+    this->decrement();
+    this->branchClose();
+    //y is zero now, so it is restored without clearing it
     this->moveStackPointerTo(temp);
     this->branchOpen();
-    //x += temp2
-    this->moveStackPointerTo(temp3);
-    this->loadValue(x, 1);
-    this->loadValue(temp2, 1);
-    this->addU8();
-    this->copyByte(temp3, x, temp4);
-    //--temp
+    this->moveStackPointerTo(y);
+    this->increment();
     this->moveStackPointerTo(temp);
     this->decrement();
+    this->branchClose();
+    //--counter
+    this->moveStackPointerTo(counter);
+    this->decrement();
     //}
     this->branchClose();
 
@@ -553,8 +816,191 @@ void BrainfuckWriter::mulU8()
     this->moveStackPointerTo(y);
 }
 
+void BrainfuckWriter::ifZeroOpen(size_t cell)
+{
+    //Unless the cell is zero the pointer moves on to the zero cell 3 above
+    //it, so the next step lands on the zero cell 4 above and skips the body.
+    //A zero cell stops it right away, and the step lands on the cell above,
+    //which isn't zero, so the body runs.
+    this->moveStackPointerTo(cell);
+    this->branchOpen();
+    this->moveStackPointerTo(cell + 3);
+    this->branchClose();
+    this->incrementStackPointer();
+    this->branchOpen();
+    //Inside the body the pointer is known to be above the cell
+    this->stack_pointer = cell + 1;
+}
+
+void BrainfuckWriter::ifZeroClose(size_t cell)
+{
+    //Both ways end up on the zero cell 4 above
+    this->moveStackPointerTo(cell + 4);
+    this->branchClose();
+}
+
+void BrainfuckWriter::divideU8()
+{
+    //Assume the stack top contains 2 u8
+    size_t x = this->stack_pointer - 2;
+    size_t y = this->stack_pointer - 1;
+    size_t remainder = this->stack_pointer;
+    size_t quotient = this->stack_pointer + 1;
+
+    //DivMod(x, y) {
+    //    remainder = 0
+    //    quotient = 0
+    //    while(x) {
+    //        --x
+    //        --y
+    //        ++remainder
+    //        if(!y) {
+    //            y = remainder
+    //            remainder = 0
+    //            ++quotient
+    //        }
+    //    }
+    //}
+
+    //Create temporary storage, the two cells above the quotient stay zero
+    //for ifZeroOpen
+    for(size_t cell = remainder; cell < remainder + 4; ++cell)
+    {
+        this->moveStackPointerTo(cell);
+        this->clearByte();
+    }
+
+    //while(x) {
+    this->moveStackPointerTo(x);
+    this->branchOpen();
+    this->decrement();
+    this->moveStackPointerTo(y);
+    this->decrement();
+    //The remainder isn't zero from here on, as ifZeroOpen needs
+    this->moveStackPointerTo(remainder);
+    this->increment();
+    //if(!y) {
+    this->ifZeroOpen(y);
+    //y = remainder, y is zero so it isn't cleared
+    this->moveStackPointerTo(remainder);
+    this->branchOpen();
+    this->decrement();
+    this->moveStackPointerTo(y);
+    this->increment();
+    this->moveStackPointerTo(remainder);
+    this->branchClose();
+    //++quotient
+    this->moveStackPointerTo(quotient);
+    this->increment();
+    //}
+    this->ifZeroClose(y);
+    //}
+    this->moveStackPointerTo(x);
+    this->branchClose();
+}
+
+void BrainfuckWriter::divModU8()
+{
+    size_t x = this->stack_pointer - 2;
+    size_t y = this->stack_pointer - 1;
+    size_t remainder = this->stack_pointer;
+    size_t quotient = this->stack_pointer + 1;
+
+    this->divideU8();
+    this->moveByte(quotient, x);
+    this->moveByte(remainder, y);
+    this->moveStackPointerTo(remainder);
+}
+
+void BrainfuckWriter::divU8()
+{
+    size_t x = this->stack_pointer - 2;
+    size_t y = this->stack_pointer - 1;
+    size_t quotient = this->stack_pointer + 1;
+
+    this->divideU8();
+    this->moveByte(quotient, x);
+
+    //Destroy the temporaries + 2nd operand
+    this->moveStackPointerTo(y);
+}
+
+void BrainfuckWriter::modU8()
+{
+    size_t x = this->stack_pointer - 2;
+    size_t y = this->stack_pointer - 1;
+    size_t remainder = this->stack_pointer;
+
+    this->divideU8();
+    this->moveByte(remainder, x);
+
+    //Destroy the temporaries + 2nd operand
+    this->moveStackPointerTo(y);
+}
+
+void BrainfuckWriter::doubleByte(size_t value, size_t times, size_t temp)
+{
+    size_t old_stack_pointer = this->stack_pointer;
+
+    //Bits shifted out wrap away, so from 8 times onwards value stays zero.
+    //Both transfers leave their source zero, so nothing is cleared in the loop.
+    this->moveStackPointerTo(temp);
+    this->clearByte();
+    this->moveStackPointerTo(times);
+    this->branchOpen();
+    this->moveStackPointerTo(value);
+    this->branchOpen();
+    this->decrement();
+    this->moveStackPointerTo(temp);
+    this->incrementBy(2);
+    this->moveStackPointerTo(value);
+    this->branchClose();
+    this->moveStackPointerTo(temp);
+    this->branchOpen();
+    this->decrement();
+    this->moveStackPointerTo(value);
+    this->increment();
+    this->moveStackPointerTo(temp);
+    this->branchClose();
+    this->moveStackPointerTo(times);
+    this->decrement();
+    this->branchClose();
+
+    //Restore stack pointer
+    this->moveStackPointerTo(old_stack_pointer);
+}
+
+void BrainfuckWriter::shlU8()
+{
+    //Assume the stack top contains 2 u8
+    size_t x = this->stack_pointer - 2;
+    size_t y = this->stack_pointer - 1;
+    size_t temp = this->stack_pointer;
+
+    this->doubleByte(x, y, temp);
+
+    //Destroy the temporaries + 2nd operand
+    this->moveStackPointerTo(y);
+}
+
+void BrainfuckWriter::shrU8()
+{
+    //Assume the stack top contains 2 u8
+    size_t y = this->stack_pointer - 1;
+    size_t power = this->stack_pointer;
+    size_t temp = this->stack_pointer + 1;
+
+    //x / (1 << y), where a power of 256 wraps to zero, which divides like 256
+    this->moveStackPointerTo(power);
+    this->clearByte();
+    this->increment();
+    this->doubleByte(power, y, temp);
+    this->moveByte(power, y);
+    this->moveStackPointerTo(power);
+    this->divU8();
+}
+
 void BrainfuckWriter::unimplemented()
 {
-    std::ostream& out = this->getOutput();
-    out << "u";
+    this->emit('u');
 }
@@ -2,47 +2,85 @@
 #define SRC_GENERATOR_BRAINFUCK_H_
 
 #include <iosfwd>
+#include <cstdint>
+#include <deque>
 #include <map>
+#include <optional>
 #include <vector>
 
 #include "types/datatype.h"
 #include "ast/node.h"
 #include "common/field.h"
+#include "common/symbol.h"
+#include "generator/variableslot.h"
+#include "generator/cellallocator.h"
 #include "ast/stat/blocknode.h"
 
 const size_t GLOBAL_SCOPE = 0;
+//Generated code is handed to the output stream in chunks of about this size
+const size_t OUTPUT_CHUNK_SIZE = 1 << 16;
 
+//Variables of a function, or of the global scope, in a single hash table on
+//the symbol id. Each name maps to its innermost binding, which remembers the
+//binding it shadows; leaving a frame pops its bindings and restores those.
 class Scope
 {
+    public:
+        static const uint32_t NO_BINDING = UINT32_MAX;
+
+        struct Binding
+        {
+            Symbol name;
+            const DataTypeBase* datatype;
+            VariableSlot* slot;
+            uint32_t shadowed;
+        };
     private:
-        std::vector<std::map<std::string, const DataTypeBase*>> declarations;
-        std::vector<std::map<std::string, size_t>> stack_locations;
+        static const uint32_t EMPTY_SLOT = UINT32_MAX;
+
+        struct Slot
+        {
+            uint32_t symbol;
+            uint32_t binding;
+        };
+
+        //Open addressing with linear probing, slots are never removed, only
+        //reset to NO_BINDING once their name goes out of scope
+        std::vector<Slot> slots;
+        size_t used_slots;
+        std::vector<Binding> bindings;
+        //Index of the first binding of every frame
+        std::vector<size_t> frames;
+
+        //Slots never move, nodes refer to them
+        std::deque<VariableSlot> variable_slots;
+        CellAllocator allocator;
+
+        Slot* findSlot(Symbol);
+        Slot& insertSlot(Symbol);
+        void grow();
     public:
-        Scope() = default;
+        Scope();
         Scope(const Scope&) = delete;
-        Scope(Scope&&);
+        Scope(Scope&&) = default;
         ~Scope() = default;
 
         Scope& operator=(const Scope&) = delete;
 
         //Declares a variable in the currently active frame
-        void declareVariable(const std::string&, const DataTypeBase* datatype);
-        void setVariableLocation(const std::string&, size_t);
+        VariableSlot* declareVariable(Symbol, const DataTypeBase* datatype, const VariableSlot&);
 
-        //Variable search
-        const DataTypeBase* findVariable(const std::string&);
-        size_t findVariableLocation(const std::string&);
+        //Variable search, nullptr if not declared
+        const Binding* findVariable(Symbol);
 
         //Checks
-        bool hasVariable(const std::string&);
-        bool hasFrameVariable(const std::string&);
+        bool hasFrameVariable(Symbol);
 
         //Frame control
         void enterFrame();
         void exitFrame();
 
-        //Scope fetch
-        std::map<std::string, const DataTypeBase*>& getFrameDeclarations();
+        CellAllocator& getAllocator();
 };
 
 class FunctionDefinition
@@ -59,12 +97,17 @@ class FunctionDefinition
 
         FunctionDefinition& operator=(const FunctionDefinition&) = delete;
 
-        bool parametersEqual(const std::vector<DataTypeBase*>& arguments);
-        DataTypeBase* getReturnType() const;
+        bool parametersEqual(const std::vector<const DataTypeBase*>& arguments);
+        bool parametersEqual(const std::vector<Field>& arguments);
+        const DataTypeBase* getReturnType() const;
 };
 
 class StructureDefinition
 {
+    private:
+        //Computed on first use, members can't change afterwards
+        mutable size_t cached_size;
+        mutable bool size_known;
     public:
         std::vector<Field> fields;
     public:
@@ -82,45 +125,48 @@ class VariableDefinition
 {
     public:
         const DataTypeBase* datatype;
-        size_t stack_location;
+        const VariableSlot* variable_slot;
     public:
-        VariableDefinition(const DataTypeBase*, size_t);
-        ~VariableDefinition() = default;
+        VariableDefinition(const DataTypeBase*, const VariableSlot*);
 
-        size_t location() const;
-        DataTypeBase* dataType() const;
+        const VariableSlot* slot() const;
+        const DataTypeBase* dataType() const;
 };
 
 class BrainfuckWriter
 {
     private:
         std::ostream* output;
+        std::string buffer;
 
         std::vector<Scope> scopes;
-        std::multimap<std::string, FunctionDefinition> functions;
-        std::map<std::string, StructureDefinition> structures;
+        std::multimap<Symbol, FunctionDefinition> functions;
+        std::map<Symbol, StructureDefinition> structures;
         std::vector<FunctionDefinition*> scope_func_lookup;
         size_t current_scope;
 
         size_t stack_pointer;
+        size_t globals_size;
+        FrameStatistics frame_statistics;
+        bool search_layout;
     public:
         BrainfuckWriter(std::ostream&);
-        ~BrainfuckWriter() = default;
+        ~BrainfuckWriter();
 
         //Declarations
-        size_t declareFunction(const std::string&, const std::vector<Field>&, const DataTypeBase*, BlockNode*);
-        void declareStructure(const std::string&, const std::vector<Field>&);
-        void declareVariable(const std::string&, const DataTypeBase*);
+        size_t declareFunction(Symbol, const std::vector<Field>&, const DataTypeBase*, BlockNode*);
+        void declareStructure(Symbol, const std::vector<Field>&);
+        const VariableSlot* declareVariable(Symbol, const DataTypeBase*);
 
         //Checks
-        bool isFunctionDeclared(const std::string&, const std::vector<Field>&);
-        bool isFunctionDeclared(const std::string&, const std::vector<DataTypeBase*>&);
-        bool isStructureDeclared(const std::string&);
+        bool isFunctionDeclared(Symbol, const std::vector<Field>&);
+        bool isFunctionDeclared(Symbol, const std::vector<const DataTypeBase*>&);
+        bool isStructureDeclared(Symbol);
 
         //Lookup operations
-        FunctionDefinition* getDeclaredFunction(const std::string&, const std::vector<DataTypeBase*>&);
-        StructureDefinition* getDeclaredStructure(const std::string&);
-        VariableDefinition* getDeclaredVariable(const std::string&);
+        FunctionDefinition* getDeclaredFunction(Symbol, const std::vector<const DataTypeBase*>&);
+        StructureDefinition* getDeclaredStructure(Symbol);
+        std::optional<VariableDefinition> getDeclaredVariable(Symbol);
 
         //Controlling function-level scope
         void switchScope(size_t);
@@ -131,9 +177,21 @@ class BrainfuckWriter
         void enterFrame();
         void exitFrame();
 
+        //Liveness of locals, recorded while type checking a function
+        void useVariable(const VariableSlot*);
+        void enterLoop();
+        void exitLoop();
+        //Lays out the locals of the current function, returns the size of its frame
+        size_t allocateFrame();
+        //Permute frames to shorten pointer moves, has to be set before type checking
+        void setLayoutSearch(bool);
+        const FrameStatistics& getFrameStatistics() const;
+
         //Output control
+        //Code is buffered, getOutput and setOutput flush before handing out a stream
         std::ostream& getOutput();
         std::ostream& setOutput(std::ostream&);
+        void flush();
 
         //Stack location
         size_t getStackLocation();
@@ -155,9 +213,8 @@ class BrainfuckWriter
         //Basic control flow structures
         void branchOpen();
         void branchClose();
-        //Scope manipulation
-        void makeStackFrame();
-        void destroyStackFrame();
+        //Starts the stack above the global variables
+        void reserveGlobals();
         //Advanced stack manipulation
         void push(const DataTypeBase*);
         void pop(const DataTypeBase*);
@@ -165,15 +222,45 @@ class BrainfuckWriter
         void pushByte(uint8_t);
         //Advanced value manipulation
         void clearByte();
+        //Moves the byte from the first cell to the second, leaving the first zero
+        void moveByte(size_t, size_t);
+        //Like moveByte, but multiplies the byte by a constant on the way
+        void scaleByte(size_t from, size_t to, uint8_t factor);
         void copyByte(size_t, size_t, size_t);
+        //Copies the byte into a number of cells a stride apart with a single loop
+        void spreadByte(size_t from, size_t to, size_t stride, size_t copies, size_t temp);
         void copyValue(size_t, size_t, size_t, size_t);
         void loadValue(size_t, size_t);
+        //Pushes a number of copies of the value, for the cost of loading it once
+        void loadValue(size_t, size_t, size_t copies);
         //8-bit unsigned arithmetic
         void addU8();
         void subU8();
         void mulU8();
+        //Dividing by zero divides by 256
+        //x y -> x/y x%y
+        void divModU8();
+        //x y -> x/y
+        void divU8();
+        //x y -> x%y
+        void modU8();
+        //x y -> x<<y
+        void shlU8();
+        //x y -> x>>y
+        void shrU8();
 
         void unimplemented();
+    private:
+        //Code between these runs only if the cell is zero, which needs the
+        //cell above it to be non-zero and the cells 3 and 4 above to be zero
+        void ifZeroOpen(size_t cell);
+        void ifZeroClose(size_t cell);
+        //Leaves x y 0 0 0 0 as 0 y-x%y x%y x/y 0 0
+        void divideU8();
+        //Doubles the byte as many times as the second cell says, which ends up zero
+        void doubleByte(size_t value, size_t times, size_t temp);
+        void emit(char);
+        void emit(size_t, char);
 };
 
 #endif
@@ -0,0 +1,268 @@
+#include "generator/cellallocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+
+CellAllocator::CellAllocator():
+    point(0) {}
+
+void CellAllocator::access(size_t range)
+{
+    LiveRange& live_range = this->ranges[range];
+
+    size_t weight = 1;
+    for(size_t i = 0; i < std::min(this->open_loops.size(), MAX_LOOP_DEPTH); ++i)
+        weight *= LOOP_WEIGHT;
+    live_range.weight += weight;
+    live_range.uses++;
+    live_range.end = this->point;
+
+    this->accesses.push_back(Use{range, weight});
+
+    //The value has to survive the back edge of the outermost loop entered since the declaration
+    auto loop = std::upper_bound(this->open_loops.begin(), this->open_loops.end(), live_range.start, [](size_t start, const Loop& loop)
+    {
+        return start < loop.start;
+    });
+    if(loop != this->open_loops.end())
+        loop->carried.push_back(range);
+
+    this->point++;
+}
+
+void CellAllocator::declare(VariableSlot* slot, size_t size)
+{
+    slot->live_range = this->ranges.size();
+    this->ranges.push_back(LiveRange{slot, size, this->point, this->point, 0, 0});
+
+    //The declaration is where the variable gets its value
+    this->access(slot->live_range);
+}
+
+void CellAllocator::use(const VariableSlot& slot)
+{
+    this->access(slot.live_range);
+}
+
+void CellAllocator::enterLoop()
+{
+    this->open_loops.push_back(Loop{this->point, {}});
+    this->point++;
+}
+
+void CellAllocator::exitLoop()
+{
+    for(size_t range : this->open_loops.back().carried)
+        this->ranges[range].end = this->point;
+    this->open_loops.pop_back();
+    this->point++;
+}
+
+size_t CellAllocator::moves(const std::vector<Register>& registers, const std::vector<std::vector<Adjacency>>& adjacent)
+{
+    size_t total = 0;
+    for(size_t a = 0; a < adjacent.size(); ++a)
+    {
+        for(const Adjacency& edge : adjacent[a])
+        {
+            //Every edge is listed at both ends
+            if(edge.first > a)
+            {
+                size_t from = registers[a].offset, to = registers[edge.first].offset;
+                total += edge.second * (from > to ? from - to : to - from);
+            }
+        }
+    }
+    return total;
+}
+
+void CellAllocator::anneal(std::vector<Register>& registers, const std::vector<std::vector<Adjacency>>& adjacent)
+{
+    //Only registers of the same size are swapped, so nothing in between moves
+    std::map<size_t, std::vector<size_t>> by_size;
+    for(size_t i = 0; i < registers.size(); ++i)
+    {
+        if(!adjacent[i].empty())
+            by_size[registers[i].size].push_back(i);
+    }
+    std::vector<const std::vector<size_t>*> groups;
+    for(auto& group : by_size)
+    {
+        if(group.second.size() > 1)
+            groups.push_back(&group.second);
+    }
+    if(groups.empty())
+        return;
+
+    //Change in moves if a and b traded places
+    auto delta = [&registers, &adjacent](size_t a, size_t b)
+    {
+        int64_t change = 0;
+        int64_t pa = registers[a].offset, pb = registers[b].offset;
+        for(const Adjacency& edge : adjacent[a])
+        {
+            if(edge.first == b)
+                continue;
+            int64_t pc = registers[edge.first].offset;
+            change += (int64_t) edge.second * (std::abs(pb - pc) - std::abs(pa - pc));
+        }
+        for(const Adjacency& edge : adjacent[b])
+        {
+            if(edge.first == a)
+                continue;
+            int64_t pc = registers[edge.first].offset;
+            change += (int64_t) edge.second * (std::abs(pa - pc) - std::abs(pb - pc));
+        }
+        return change;
+    };
+
+    std::mt19937 random(LAYOUT_SEED);
+    auto pick = [&random](size_t count)
+    {
+        return (size_t) (random() % count);
+    };
+    //Standard distributions differ between libraries, this doesn't
+    auto chance = [&random]()
+    {
+        return random() / 4294967296.0;
+    };
+
+    size_t candidates = 0;
+    for(const std::vector<size_t>* group : groups)
+        candidates += group->size();
+    size_t steps = std::min(candidates * SEARCH_STEPS_PER_CELL, MAX_SEARCH_STEPS);
+
+    //Start hot enough to accept a typical uphill step half of the time
+    double average = 0;
+    for(size_t i = 0; i < 64; ++i)
+    {
+        const std::vector<size_t>& group = *groups[pick(groups.size())];
+        average += std::abs(delta(group[pick(group.size())], group[pick(group.size())]));
+    }
+    double temperature = std::max(average / 64 / std::log(2.0), 1.0);
+    double cooling = std::pow(0.01 / temperature, 1.0 / steps);
+
+    int64_t current = 0, best = 0;
+    std::vector<size_t> best_offsets;
+    for(const Register& reg : registers)
+        best_offsets.push_back(reg.offset);
+
+    for(size_t step = 0; step < steps; ++step, temperature *= cooling)
+    {
+        const std::vector<size_t>& group = *groups[pick(groups.size())];
+        size_t a = group[pick(group.size())], b = group[pick(group.size())];
+        if(a == b)
+            continue;
+
+        int64_t change = delta(a, b);
+        if(change > 0 && chance() >= std::exp(-change / temperature))
+            continue;
+
+        std::swap(registers[a].offset, registers[b].offset);
+        current += change;
+        if(current < best)
+        {
+            best = current;
+            for(size_t i = 0; i < registers.size(); ++i)
+                best_offsets[i] = registers[i].offset;
+        }
+    }
+
+    for(size_t i = 0; i < registers.size(); ++i)
+        registers[i].offset = best_offsets[i];
+}
+
+void CellAllocator::searchLayout(std::vector<Register>& registers, const std::vector<size_t>& assigned, FrameStatistics& statistics)
+{
+    //The pointer walks from every access to the next one
+    std::vector<std::pair<uint64_t, size_t>> walks;
+    for(size_t i = 1; i < this->accesses.size(); ++i)
+    {
+        size_t a = assigned[this->accesses[i - 1].range], b = assigned[this->accesses[i].range];
+        if(a != b)
+            walks.emplace_back((uint64_t) std::min(a, b) << 32 | std::max(a, b), this->accesses[i].weight);
+    }
+    std::sort(walks.begin(), walks.end());
+
+    std::vector<std::vector<Adjacency>> adjacent(registers.size());
+    for(size_t i = 0; i < walks.size();)
+    {
+        size_t a = walks[i].first >> 32, b = walks[i].first & UINT32_MAX;
+        size_t weight = 0;
+        for(uint64_t pair = walks[i].first; i < walks.size() && walks[i].first == pair; ++i)
+            weight += walks[i].second;
+        adjacent[a].emplace_back(b, weight);
+        adjacent[b].emplace_back(a, weight);
+    }
+
+    statistics.unsearched_moves += CellAllocator::moves(registers, adjacent);
+    CellAllocator::anneal(registers, adjacent);
+    statistics.moves += CellAllocator::moves(registers, adjacent);
+}
+
+size_t CellAllocator::allocate(FrameStatistics& statistics, bool search_layout)
+{
+    std::vector<Register> registers;
+    std::vector<size_t> assigned(this->ranges.size());
+
+    typedef std::pair<size_t, size_t> Active;
+    std::priority_queue<Active, std::vector<Active>, std::greater<Active>> active;
+    std::map<size_t, std::vector<size_t>> free_registers;
+
+    //Ranges are created in order of their start
+    for(size_t i = 0; i < this->ranges.size(); ++i)
+    {
+        const LiveRange& range = this->ranges[i];
+        while(!active.empty() && active.top().first < range.start)
+        {
+            size_t expired = active.top().second;
+            free_registers[registers[expired].size].push_back(expired);
+            active.pop();
+        }
+
+        std::vector<size_t>& candidates = free_registers[range.size];
+        size_t chosen;
+        if(candidates.empty())
+        {
+            chosen = registers.size();
+            registers.push_back(Register{range.size, 0, 0});
+        }
+        else
+        {
+            chosen = candidates.back();
+            candidates.pop_back();
+        }
+
+        registers[chosen].weight += range.weight;
+        assigned[i] = chosen;
+        active.emplace(range.end, chosen);
+    }
+
+    //Heaviest per cell at the top, closest to the stack
+    std::vector<size_t> order(registers.size());
+    for(size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&registers](size_t a, size_t b)
+    {
+        return registers[a].weight * registers[b].size < registers[b].weight * registers[a].size;
+    });
+
+    size_t frame_size = 0;
+    for(size_t index : order)
+    {
+        registers[index].offset = frame_size;
+        frame_size += registers[index].size;
+    }
+
+    if(search_layout)
+        this->searchLayout(registers, assigned, statistics);
+
+    for(size_t i = 0; i < this->ranges.size(); ++i)
+        this->ranges[i].slot->offset = registers[assigned[i]].offset;
+
+    return frame_size;
+}
@@ -0,0 +1,97 @@
+#ifndef SRC_GENERATOR_CELLALLOCATOR_H_
+#define SRC_GENERATOR_CELLALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "generator/variableslot.h"
+
+//Distances between consecutive accesses to the variables of a frame, weighted
+//by loop depth, before and after the layout search
+struct FrameStatistics
+{
+    size_t unsearched_moves;
+    size_t moves;
+};
+
+//Lays out the frame of a function. The events of type checking are numbered
+//as program points, every local gets a live range from its declaration to its
+//last use, and ranges that don't overlap share cells (linear scan). Variables
+//used before a loop and inside it stay live until the loop ends. The cells
+//used most, weighted by loop depth, go to the top of the frame, right below
+//the stack where expressions are evaluated.
+//Optionally the cells are then permuted by simulated annealing to bring cells
+//accessed one after the other close together. The search is seeded with a
+//constant, so the same program always gets the same layout.
+class CellAllocator
+{
+    private:
+        //Each loop level multiplies the weight of a use
+        static constexpr size_t LOOP_WEIGHT = 8;
+        static constexpr size_t MAX_LOOP_DEPTH = 10;
+        static constexpr uint32_t LAYOUT_SEED = 0x5EED;
+        static constexpr size_t SEARCH_STEPS_PER_CELL = 64;
+        static constexpr size_t MAX_SEARCH_STEPS = 1 << 22;
+
+        struct LiveRange
+        {
+            VariableSlot* slot;
+            size_t size;
+            size_t start;
+            size_t end;
+            size_t weight;
+            size_t uses;
+        };
+
+        struct Use
+        {
+            size_t range;
+            size_t weight;
+        };
+
+        //Cells shared by ranges that never overlap
+        struct Register
+        {
+            size_t size;
+            size_t weight;
+            size_t offset;
+        };
+
+        //Neighbouring register and how often the pointer moves to it
+        typedef std::pair<size_t, size_t> Adjacency;
+
+        struct Loop
+        {
+            size_t start;
+            //Ranges that started before the loop and are used inside it
+            std::vector<size_t> carried;
+        };
+
+        std::vector<LiveRange> ranges;
+        std::vector<Use> accesses;
+        std::vector<Loop> open_loops;
+        size_t point;
+
+        void access(size_t range);
+        //Weighted distance between consecutive accesses
+        static size_t moves(const std::vector<Register>&, const std::vector<std::vector<Adjacency>>&);
+        static void anneal(std::vector<Register>&, const std::vector<std::vector<Adjacency>>&);
+        //Permutes the registers to bring consecutive accesses close together
+        void searchLayout(std::vector<Register>&, const std::vector<size_t>& assigned, FrameStatistics&);
+    public:
+        CellAllocator();
+
+        //Starts the live range of the variable in the slot
+        void declare(VariableSlot* slot, size_t size);
+        void use(const VariableSlot& slot);
+
+        void enterLoop();
+        void exitLoop();
+
+        //Assigns the offsets of all declared slots, returns the size of the frame
+        size_t allocate(FrameStatistics&, bool search_layout);
+};
+
+#endif
@@ -0,0 +1,269 @@
+#include "generator/optimizer.h"
+
+BrainfuckOptimizer::TapeState::TapeState(bool default_zero):
+    default_zero(default_zero), pointer(0) {}
+
+int BrainfuckOptimizer::TapeState::get(long offset) const
+{
+    auto it = this->cells.find(offset);
+    if(it != this->cells.end())
+        return it->second;
+    return this->default_zero ? 0 : UNKNOWN;
+}
+
+void BrainfuckOptimizer::TapeState::set(long offset, int value)
+{
+    this->cells[offset] = value;
+}
+
+void BrainfuckOptimizer::TapeState::forget()
+{
+    this->cells.clear();
+    this->default_zero = false;
+}
+
+BrainfuckOptimizer::BrainfuckOptimizer():
+    instructions_before(0), instructions_after(0) {}
+
+std::string BrainfuckOptimizer::optimize(const std::string& code)
+{
+    std::vector<Instruction> program;
+    for(char c : code)
+    {
+        switch(c)
+        {
+            case '+': program.push_back({'+', 1}); break;
+            case '-': program.push_back({'+', 255}); break;
+            case '>': program.push_back({'>', 1}); break;
+            case '<': program.push_back({'>', -1}); break;
+            case '[':
+            case ']':
+            case '.':
+            case ',':
+                program.push_back({c, 1});
+                break;
+            default:
+                break;
+        }
+    }
+
+    this->instructions_before = countInstructions(code);
+
+    std::vector<size_t> loops;
+    if(!this->matchLoops(program, loops))
+    {
+        //Unbalanced code has no well defined meaning, leave it alone
+        this->instructions_after = this->instructions_before;
+        return code;
+    }
+
+    //Removing a loop can make its neighbours cancel, so repeat until nothing changes
+    while(true)
+    {
+        program = this->fold(program);
+        this->matchLoops(program, loops);
+
+        std::vector<Instruction> result;
+        TapeState state(true);
+        this->propagate(program, loops, 0, program.size(), state, result);
+
+        if(result.size() == program.size())
+            break;
+        program = std::move(result);
+    }
+
+    std::string result = this->emit(program);
+    this->instructions_after = countInstructions(result);
+    return result;
+}
+
+size_t BrainfuckOptimizer::getInstructionsBefore() const
+{
+    return this->instructions_before;
+}
+
+size_t BrainfuckOptimizer::getInstructionsAfter() const
+{
+    return this->instructions_after;
+}
+
+size_t BrainfuckOptimizer::countInstructions(const std::string& code)
+{
+    size_t count = 0;
+    for(char c : code)
+    {
+        switch(c)
+        {
+            case '+': case '-': case '<': case '>':
+            case '[': case ']': case '.': case ',':
+                ++count;
+                break;
+            default:
+                break;
+        }
+    }
+    return count;
+}
+
+std::vector<BrainfuckOptimizer::Instruction> BrainfuckOptimizer::fold(const std::vector<Instruction>& program)
+{
+    std::vector<Instruction> result;
+    for(const Instruction& instruction : program)
+    {
+        bool foldable = instruction.op == '+' || instruction.op == '>';
+        if(foldable && !result.empty() && result.back().op == instruction.op)
+        {
+            result.back().value += instruction.value;
+            if(instruction.op == '+')
+                result.back().value &= 0xFF;
+            if(result.back().value == 0)
+                result.pop_back();
+        }
+        else
+            result.push_back(instruction);
+    }
+    return result;
+}
+
+bool BrainfuckOptimizer::matchLoops(const std::vector<Instruction>& program, std::vector<size_t>& loops)
+{
+    std::vector<size_t> open;
+    loops.assign(program.size(), 0);
+    for(size_t i = 0; i < program.size(); ++i)
+    {
+        if(program[i].op == '[')
+            open.push_back(i);
+        else if(program[i].op == ']')
+        {
+            if(open.empty())
+                return false;
+            loops[i] = open.back();
+            loops[open.back()] = i;
+            open.pop_back();
+        }
+    }
+    return open.empty();
+}
+
+//Collects the cells a loop may write, relative to the cell it tests. Fails if the
+//loop (or any loop inside it) does not return the pointer to where it started.
+bool BrainfuckOptimizer::loopEffect(const std::vector<Instruction>& program, const std::vector<size_t>& loops, size_t start, std::set<long>& touched)
+{
+    long offset = 0;
+    for(size_t i = start + 1; i < loops[start]; ++i)
+    {
+        switch(program[i].op)
+        {
+            case '+':
+            case ',':
+                touched.insert(offset);
+                break;
+            case '>':
+                offset += program[i].value;
+                break;
+            case '[':
+            {
+                std::set<long> inner;
+                if(!this->loopEffect(program, loops, i, inner))
+                    return false;
+                for(long cell : inner)
+                    touched.insert(offset + cell);
+                i = loops[i];
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return offset == 0;
+}
+
+void BrainfuckOptimizer::propagate(const std::vector<Instruction>& program, const std::vector<size_t>& loops, size_t begin, size_t end, TapeState& state, std::vector<Instruction>& result)
+{
+    for(size_t i = begin; i < end; ++i)
+    {
+        const Instruction& instruction = program[i];
+        switch(instruction.op)
+        {
+            case '+':
+            {
+                int value = state.get(state.pointer);
+                if(value != TapeState::UNKNOWN)
+                    state.set(state.pointer, (value + instruction.value) & 0xFF);
+                result.push_back(instruction);
+                break;
+            }
+            case '>':
+                state.pointer += instruction.value;
+                result.push_back(instruction);
+                break;
+            case ',':
+                state.set(state.pointer, TapeState::UNKNOWN);
+                result.push_back(instruction);
+                break;
+            case '[':
+            {
+                //A loop over a cell that is known to be zero never runs
+                if(state.get(state.pointer) == 0)
+                {
+                    i = loops[i];
+                    break;
+                }
+
+                //Nothing is known about the tape once the body repeats
+                TapeState body(false);
+                result.push_back(instruction);
+                this->propagate(program, loops, i + 1, loops[i], body, result);
+                result.push_back(program[loops[i]]);
+
+                std::set<long> touched;
+                if(this->loopEffect(program, loops, i, touched))
+                {
+                    for(long cell : touched)
+                        state.set(state.pointer + cell, TapeState::UNKNOWN);
+                }
+                else
+                {
+                    state.forget();
+                    state.pointer = 0;
+                }
+                //The loop only exits on a zero cell
+                state.set(state.pointer, 0);
+
+                i = loops[i];
+                break;
+            }
+            default:
+                result.push_back(instruction);
+                break;
+        }
+    }
+}
+
+std::string BrainfuckOptimizer::emit(const std::vector<Instruction>& program)
+{
+    std::string result;
+    for(const Instruction& instruction : program)
+    {
+        switch(instruction.op)
+        {
+            case '+':
+                //Cells wrap, so take the shorter way around
+                if(instruction.value <= 128)
+                    result.append(instruction.value, '+');
+                else
+                    result.append(256 - instruction.value, '-');
+                break;
+            case '>':
+                if(instruction.value > 0)
+                    result.append(instruction.value, '>');
+                else
+                    result.append(-instruction.value, '<');
+                break;
+            default:
+                result.append(1, instruction.op);
+                break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef SRC_GENERATOR_OPTIMIZER_H_
+#define SRC_GENERATOR_OPTIMIZER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+//Peephole optimizer for generated brainfuck. It assumes the same machine BrainfuckWriter
+//generates code for: a zero-initialized tape of 8-bit cells that wrap around.
+class BrainfuckOptimizer
+{
+    private:
+        struct Instruction
+        {
+            char op;
+            long value;
+        };
+
+        //What is known about the tape, relative to where the pass started
+        class TapeState
+        {
+            private:
+                std::map<long, int> cells;
+                bool default_zero;
+            public:
+                static const int UNKNOWN = -1;
+
+                long pointer;
+
+                TapeState(bool);
+
+                int get(long) const;
+                void set(long, int);
+                void forget();
+        };
+
+        size_t instructions_before;
+        size_t instructions_after;
+    public:
+        BrainfuckOptimizer();
+        ~BrainfuckOptimizer() = default;
+
+        std::string optimize(const std::string&);
+
+        //Instruction counts of the last optimized program
+        size_t getInstructionsBefore() const;
+        size_t getInstructionsAfter() const;
+    private:
+        static size_t countInstructions(const std::string&);
+
+        std::vector<Instruction> fold(const std::vector<Instruction>&);
+        bool matchLoops(const std::vector<Instruction>&, std::vector<size_t>&);
+        bool loopEffect(const std::vector<Instruction>&, const std::vector<size_t>&, size_t, std::set<long>&);
+        void propagate(const std::vector<Instruction>&, const std::vector<size_t>&, size_t, size_t, TapeState&, std::vector<Instruction>&);
+        std::string emit(const std::vector<Instruction>&);
+};
+
+#endif
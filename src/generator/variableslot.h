@@ -0,0 +1,17 @@
+#ifndef SRC_GENERATOR_VARIABLESLOT_H_
+#define SRC_GENERATOR_VARIABLESLOT_H_
+
+#include <cstddef>
+
+//Resolved location of a variable, bound during type checking. Globals are
+//placed as they are declared, the offsets of locals within the frame of their
+//function are filled in once the whole function has been checked.
+struct VariableSlot
+{
+    bool global;
+    size_t offset;
+    //Index of the live range of a local in the allocator of its function
+    size_t live_range;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "ir/builder.h"
+
+IrBuilder::IrBuilder(IrProgram& program):
+    program(&program), current_function(0)
+{
+    this->switchFunction(0);
+}
+
+IrFunction& IrBuilder::function()
+{
+    return this->program->functions[this->current_function];
+}
+
+IrBlock& IrBuilder::block()
+{
+    return this->function().blocks[this->current_blocks[this->current_function]];
+}
+
+IrValue IrBuilder::append(IrOpcode opcode, const DataTypeBase* type, IrValue lhs, IrValue rhs)
+{
+    IrValue result = this->function().value_count++;
+    this->block().instructions.push_back(IrInstruction{opcode, result, {lhs, rhs}, type, {0}});
+    return result;
+}
+
+void IrBuilder::terminate(IrTerminatorKind kind, IrValue value, IrBlockId first, IrBlockId second, IrBlockId merge)
+{
+    this->block().terminator = IrTerminator{kind, value, {first, second}, merge};
+}
+
+void IrBuilder::switchFunction(size_t index)
+{
+    //Functions get their entry block when first switched to
+    if(index >= this->program->functions.size())
+    {
+        this->program->functions.resize(index + 1);
+        this->current_blocks.resize(index + 1, 0);
+    }
+    IrFunction& function = this->program->functions[index];
+    if(function.blocks.empty())
+        function.blocks.emplace_back();
+    this->current_function = index;
+}
+
+size_t IrBuilder::getFunction()
+{
+    return this->current_function;
+}
+
+void IrBuilder::defineFunction(Symbol name, size_t frame_size)
+{
+    this->function().name = name;
+    this->function().frame_size = frame_size;
+}
+
+IrValue IrBuilder::constant(const DataTypeBase* type, uint64_t value)
+{
+    IrValue result = this->append(IrOpcode::CONSTANT, type, NO_VALUE, NO_VALUE);
+    this->block().instructions.back().immediate = value;
+    return result;
+}
+
+IrValue IrBuilder::load(const DataTypeBase* type, const VariableSlot* slot)
+{
+    IrValue result = this->append(IrOpcode::LOAD, type, NO_VALUE, NO_VALUE);
+    this->block().instructions.back().slot = slot;
+    return result;
+}
+
+void IrBuilder::store(const DataTypeBase* type, const VariableSlot* slot, IrValue value)
+{
+    this->block().instructions.push_back(IrInstruction{IrOpcode::STORE, NO_VALUE, {value, NO_VALUE}, type, {0}});
+    this->block().instructions.back().slot = slot;
+}
+
+IrValue IrBuilder::unary(IrOpcode opcode, const DataTypeBase* type, IrValue operand)
+{
+    return this->append(opcode, type, operand, NO_VALUE);
+}
+
+IrValue IrBuilder::binary(IrOpcode opcode, const DataTypeBase* type, IrValue lhs, IrValue rhs)
+{
+    return this->append(opcode, type, lhs, rhs);
+}
+
+IrValue IrBuilder::assembly(const DataTypeBase* type, const std::string& code, const std::vector<IrValue>& arguments, bool pure)
+{
+    IrFunction& function = this->function();
+    function.assembly.push_back(IrAssembly{&code, arguments, pure});
+
+    IrValue result = this->append(IrOpcode::ASM, type, NO_VALUE, NO_VALUE);
+    this->block().instructions.back().immediate = function.assembly.size() - 1;
+    return result;
+}
+
+IrValue IrBuilder::unimplemented(const DataTypeBase* type)
+{
+    return this->append(IrOpcode::UNIMPLEMENTED, type, NO_VALUE, NO_VALUE);
+}
+
+IrBlockId IrBuilder::createBlock()
+{
+    IrFunction& function = this->function();
+    function.blocks.emplace_back();
+    return function.blocks.size() - 1;
+}
+
+void IrBuilder::setBlock(IrBlockId block)
+{
+    this->current_blocks[this->current_function] = block;
+}
+
+void IrBuilder::jump(IrBlockId target)
+{
+    this->terminate(IrTerminatorKind::JUMP, NO_VALUE, target, 0, 0);
+}
+
+void IrBuilder::branch(IrValue condition, IrBlockId taken, IrBlockId not_taken, IrBlockId merge)
+{
+    this->terminate(IrTerminatorKind::BRANCH, condition, taken, not_taken, merge);
+}
+
+void IrBuilder::loop(IrValue condition, IrBlockId body, IrBlockId exit)
+{
+    this->terminate(IrTerminatorKind::LOOP, condition, body, exit, exit);
+}
@@ -0,0 +1,49 @@
+#ifndef SRC_IR_BUILDER_H_
+#define SRC_IR_BUILDER_H_
+
+#include <string>
+#include <vector>
+
+#include "ir/ir.h"
+
+//Appends instructions to the current block of the current function. Every
+//function keeps its own current block, so lowering can leave one function
+//for another and come back, like the writer does with scopes.
+class IrBuilder
+{
+    private:
+        IrProgram* program;
+        size_t current_function;
+        std::vector<IrBlockId> current_blocks;
+
+        IrFunction& function();
+        IrBlock& block();
+        IrValue append(IrOpcode, const DataTypeBase*, IrValue, IrValue);
+        void terminate(IrTerminatorKind, IrValue, IrBlockId, IrBlockId, IrBlockId);
+    public:
+        IrBuilder(IrProgram&);
+
+        //Controlling the function being built, indexed by scope
+        void switchFunction(size_t);
+        size_t getFunction();
+        void defineFunction(Symbol, size_t frame_size);
+
+        //Values
+        IrValue constant(const DataTypeBase*, uint64_t);
+        IrValue load(const DataTypeBase*, const VariableSlot*);
+        void store(const DataTypeBase*, const VariableSlot*, IrValue);
+        IrValue unary(IrOpcode, const DataTypeBase*, IrValue);
+        IrValue binary(IrOpcode, const DataTypeBase*, IrValue, IrValue);
+        IrValue assembly(const DataTypeBase*, const std::string&, const std::vector<IrValue>&, bool pure);
+        IrValue unimplemented(const DataTypeBase*);
+
+        //Blocks
+        IrBlockId createBlock();
+        void setBlock(IrBlockId);
+        //Terminate the current block
+        void jump(IrBlockId);
+        void branch(IrValue, IrBlockId taken, IrBlockId not_taken, IrBlockId merge);
+        void loop(IrValue, IrBlockId body, IrBlockId exit);
+};
+
+#endif
@@ -0,0 +1,260 @@
+#include "ir/deadcode.h"
+
+static bool contains(const std::vector<uint64_t>& set, size_t slot)
+{
+    return (set[slot / 64] >> (slot % 64)) & 1;
+}
+
+static void insert(std::vector<uint64_t>& set, size_t slot)
+{
+    set[slot / 64] |= (uint64_t) 1 << (slot % 64);
+}
+
+static void erase(std::vector<uint64_t>& set, size_t slot)
+{
+    set[slot / 64] &= ~((uint64_t) 1 << (slot % 64));
+}
+
+static void insertAll(std::vector<uint64_t>& set)
+{
+    for(uint64_t& word : set)
+        word = ~(uint64_t) 0;
+}
+
+static void merge(std::vector<uint64_t>& set, const std::vector<uint64_t>& other)
+{
+    for(size_t i = 0; i < set.size(); ++i)
+        set[i] |= other[i];
+}
+
+DeadCodeEliminator::DeadCodeEliminator():
+    function(nullptr), instructions_before(0), instructions_after(0) {}
+
+size_t DeadCodeEliminator::getInstructionsBefore() const
+{
+    return this->instructions_before;
+}
+
+size_t DeadCodeEliminator::getInstructionsAfter() const
+{
+    return this->instructions_after;
+}
+
+void DeadCodeEliminator::eliminate(IrProgram& program)
+{
+    for(size_t i = 0; i < program.functions.size(); ++i)
+        this->eliminate(program.functions[i], i != 0);
+}
+
+void DeadCodeEliminator::eliminate(IrFunction& function, bool globals_live)
+{
+    this->function = &function;
+    for(const IrBlock& block : function.blocks)
+        this->instructions_before += block.instructions.size();
+
+    this->indexSlots(globals_live);
+    this->countUses();
+    do
+    {
+        this->computeLiveness();
+    }
+    while(this->sweep());
+
+    for(const IrBlock& block : function.blocks)
+        this->instructions_after += block.instructions.size();
+}
+
+size_t DeadCodeEliminator::slotIndex(const VariableSlot* slot)
+{
+    return this->slots.emplace(slot, this->slots.size()).first->second;
+}
+
+void DeadCodeEliminator::indexSlots(bool globals_live)
+{
+    this->slots.clear();
+    for(const IrBlock& block : this->function->blocks)
+    {
+        for(const IrInstruction& instruction : block.instructions)
+        {
+            if(instruction.opcode == IrOpcode::LOAD || instruction.opcode == IrOpcode::STORE)
+                this->slotIndex(instruction.slot);
+        }
+    }
+
+    this->exit_live.assign((this->slots.size() + 63) / 64, 0);
+    if(globals_live)
+    {
+        for(const auto& slot : this->slots)
+        {
+            if(slot.first->global)
+                insert(this->exit_live, slot.second);
+        }
+    }
+}
+
+void DeadCodeEliminator::countUses()
+{
+    this->uses.assign(this->function->value_count, 0);
+    for(const IrBlock& block : this->function->blocks)
+    {
+        for(const IrInstruction& instruction : block.instructions)
+        {
+            for(IrValue operand : instruction.operands)
+            {
+                if(operand != NO_VALUE)
+                    this->uses[operand]++;
+            }
+            if(instruction.opcode == IrOpcode::ASM)
+            {
+                for(IrValue argument : this->function->assembly[instruction.immediate].arguments)
+                    this->uses[argument]++;
+            }
+        }
+        if(block.terminator.value != NO_VALUE)
+            this->uses[block.terminator.value]++;
+    }
+}
+
+void DeadCodeEliminator::computeLiveness()
+{
+    size_t count = this->function->blocks.size();
+    this->live_in.assign(count, SlotSet(this->exit_live.size(), 0));
+    this->live_out.assign(count, SlotSet(this->exit_live.size(), 0));
+
+    //Blocks mostly jump forward, so going backward settles in a few rounds
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        for(size_t i = count; i-- > 0;)
+        {
+            const IrTerminator& terminator = this->function->blocks[i].terminator;
+            SlotSet& out = this->live_out[i];
+            switch(terminator.kind)
+            {
+                case IrTerminatorKind::JUMP:
+                    out = this->live_in[terminator.targets[0]];
+                    break;
+                case IrTerminatorKind::BRANCH:
+                case IrTerminatorKind::LOOP:
+                    out = this->live_in[terminator.targets[0]];
+                    merge(out, this->live_in[terminator.targets[1]]);
+                    break;
+                case IrTerminatorKind::RETURN:
+                    out = this->exit_live;
+                    break;
+            }
+
+            SlotSet in = out;
+            this->transfer(this->function->blocks[i], in);
+            if(in != this->live_in[i])
+            {
+                this->live_in[i] = std::move(in);
+                changed = true;
+            }
+        }
+    }
+}
+
+void DeadCodeEliminator::transfer(const IrBlock& block, SlotSet& live)
+{
+    for(auto it = block.instructions.rbegin(); it != block.instructions.rend(); ++it)
+    {
+        switch(it->opcode)
+        {
+            case IrOpcode::STORE:
+                erase(live, this->slots[it->slot]);
+                break;
+            case IrOpcode::LOAD:
+                insert(live, this->slots[it->slot]);
+                break;
+            case IrOpcode::UNIMPLEMENTED:
+                insertAll(live);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool DeadCodeEliminator::sweep()
+{
+    bool removed = false;
+    for(size_t i = 0; i < this->function->blocks.size(); ++i)
+    {
+        SlotSet live = this->live_out[i];
+        removed |= this->sweep(this->function->blocks[i], live);
+    }
+    return removed;
+}
+
+bool DeadCodeEliminator::sweep(IrBlock& block, SlotSet& live)
+{
+    std::vector<IrInstruction>& instructions = block.instructions;
+    std::vector<bool> dead(instructions.size(), false);
+    bool removed = false;
+
+    //Backwards, so whatever only fed removed instructions goes with them
+    for(size_t i = instructions.size(); i-- > 0;)
+    {
+        const IrInstruction& instruction = instructions[i];
+        switch(instruction.opcode)
+        {
+            case IrOpcode::STORE:
+            {
+                size_t slot = this->slots[instruction.slot];
+                if(contains(live, slot))
+                    erase(live, slot);
+                else
+                    dead[i] = true;
+                break;
+            }
+            case IrOpcode::LOAD:
+                if(this->uses[instruction.result] != 0)
+                    insert(live, this->slots[instruction.slot]);
+                else
+                    dead[i] = true;
+                break;
+            case IrOpcode::ASM:
+            {
+                const IrAssembly& assembly = this->function->assembly[instruction.immediate];
+                if(assembly.pure && this->uses[instruction.result] == 0)
+                {
+                    dead[i] = true;
+                    for(IrValue argument : assembly.arguments)
+                        this->release(argument);
+                }
+                continue;
+            }
+            case IrOpcode::UNIMPLEMENTED:
+                insertAll(live);
+                break;
+            default:
+                dead[i] = this->uses[instruction.result] == 0;
+                break;
+        }
+
+        if(dead[i])
+        {
+            for(IrValue operand : instruction.operands)
+                this->release(operand);
+        }
+    }
+
+    size_t kept = 0;
+    for(size_t i = 0; i < instructions.size(); ++i)
+    {
+        if(!dead[i])
+            instructions[kept++] = instructions[i];
+        else
+            removed = true;
+    }
+    instructions.resize(kept);
+    return removed;
+}
+
+void DeadCodeEliminator::release(IrValue value)
+{
+    if(value != NO_VALUE)
+        this->uses[value]--;
+}
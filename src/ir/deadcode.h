@@ -0,0 +1,57 @@
+#ifndef SRC_IR_DEADCODE_H_
+#define SRC_IR_DEADCODE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ir/ir.h"
+
+//Removes instructions whose values are never used and stores to variables
+//that are overwritten or never read again. Stores are found dead through the
+//liveness of variables across blocks, which is computed again after every
+//sweep until nothing more can be removed. Loads, arithmetic and pure assembly
+//have no side effects. Other assembly is always kept, but like all assembly
+//it only sees its arguments, as variables have no fixed place to find them
+//at. Anything unimplemented (calls) is kept and reads every variable.
+class DeadCodeEliminator
+{
+    private:
+        typedef std::vector<uint64_t> SlotSet;
+
+        IrFunction* function;
+        //Dense indices of the variables the function touches
+        std::unordered_map<const VariableSlot*, size_t> slots;
+        std::vector<uint32_t> uses;
+        //Variables live where the function returns, and around every block
+        SlotSet exit_live;
+        std::vector<SlotSet> live_in;
+        std::vector<SlotSet> live_out;
+
+        size_t instructions_before;
+        size_t instructions_after;
+    public:
+        DeadCodeEliminator();
+        ~DeadCodeEliminator() = default;
+
+        void eliminate(IrProgram&);
+        //Global variables outlive functions, but not the global code
+        void eliminate(IrFunction&, bool globals_live);
+
+        //Instruction counts of everything eliminated so far
+        size_t getInstructionsBefore() const;
+        size_t getInstructionsAfter() const;
+    private:
+        size_t slotIndex(const VariableSlot*);
+        void indexSlots(bool globals_live);
+        void countUses();
+
+        void computeLiveness();
+        void transfer(const IrBlock&, SlotSet&);
+        bool sweep();
+        bool sweep(IrBlock&, SlotSet&);
+        void release(IrValue);
+};
+
+#endif
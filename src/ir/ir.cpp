@@ -0,0 +1,145 @@
+#include "ir/ir.h"
+#include "types/datatype.h"
+
+#include <iostream>
+
+const char* IR_OPCODE_NAMES[] = {
+    "const",
+    "load",
+    "store",
+    "add",
+    "sub",
+    "mul",
+    "div",
+    "mod",
+    "and",
+    "or",
+    "xor",
+    "shl",
+    "shr",
+    "neg",
+    "not",
+    "cast",
+    "asm",
+    "unimplemented"
+};
+
+bool isOperator(IrOpcode opcode)
+{
+    return opcode >= IrOpcode::ADD && opcode <= IrOpcode::CAST;
+}
+
+bool isCommutative(IrOpcode opcode)
+{
+    switch(opcode)
+    {
+        case IrOpcode::ADD:
+        case IrOpcode::MUL:
+        case IrOpcode::AND:
+        case IrOpcode::OR:
+        case IrOpcode::XOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+IrBlock::IrBlock():
+    terminator{IrTerminatorKind::RETURN, NO_VALUE, {0, 0}, 0} {}
+
+IrFunction::IrFunction():
+    name(Symbol::intern("")), value_count(0), frame_size(0) {}
+
+static void printSlot(std::ostream& os, const VariableSlot* slot)
+{
+    os << (slot->global ? "@global+" : "@frame+") << slot->offset;
+}
+
+static void printInstruction(std::ostream& os, const IrFunction& function, const IrInstruction& instruction)
+{
+    os << "    ";
+    if(instruction.result != NO_VALUE)
+        os << "%" << instruction.result << " = ";
+    os << IR_OPCODE_NAMES[(size_t)instruction.opcode] << " " << *instruction.type;
+
+    switch(instruction.opcode)
+    {
+        case IrOpcode::CONSTANT:
+            os << " " << instruction.immediate;
+            break;
+        case IrOpcode::LOAD:
+            os << " ";
+            printSlot(os, instruction.slot);
+            break;
+        case IrOpcode::STORE:
+            os << " ";
+            printSlot(os, instruction.slot);
+            os << ", %" << instruction.operands[0];
+            break;
+        case IrOpcode::ASM:
+        {
+            const IrAssembly& assembly = function.assembly[instruction.immediate];
+            os << (assembly.pure ? " pure {" : " {") << *assembly.code << "} (";
+            for(size_t i = 0; i < assembly.arguments.size(); ++i)
+                os << (i == 0 ? "%" : ", %") << assembly.arguments[i];
+            os << ")";
+            break;
+        }
+        default:
+            for(size_t i = 0; i < 2 && instruction.operands[i] != NO_VALUE; ++i)
+                os << (i == 0 ? " %" : ", %") << instruction.operands[i];
+            break;
+    }
+    os << std::endl;
+}
+
+static void printTerminator(std::ostream& os, const IrTerminator& terminator)
+{
+    os << "    ";
+    switch(terminator.kind)
+    {
+        case IrTerminatorKind::JUMP:
+            os << "jump block " << terminator.targets[0];
+            break;
+        case IrTerminatorKind::BRANCH:
+            os << "branch %" << terminator.value << ", block " << terminator.targets[0] <<
+                  ", block " << terminator.targets[1] << " (merge block " << terminator.merge << ")";
+            break;
+        case IrTerminatorKind::LOOP:
+            os << "loop %" << terminator.value << ", block " << terminator.targets[0] <<
+                  ", exit block " << terminator.targets[1];
+            break;
+        case IrTerminatorKind::RETURN:
+            os << "return";
+            if(terminator.value != NO_VALUE)
+                os << " %" << terminator.value;
+            break;
+    }
+    os << std::endl;
+}
+
+void IrFunction::print(std::ostream& os) const
+{
+    if(this->name.str().empty())
+        os << "global code";
+    else
+        os << "function " << this->name;
+    os << " (frame of " << this->frame_size << " cells):" << std::endl;
+
+    for(size_t i = 0; i < this->blocks.size(); ++i)
+    {
+        os << "  block " << i << ":" << std::endl;
+        for(const IrInstruction& instruction : this->blocks[i].instructions)
+            printInstruction(os, *this, instruction);
+        printTerminator(os, this->blocks[i].terminator);
+    }
+}
+
+void IrProgram::print(std::ostream& os) const
+{
+    for(const IrFunction& function : this->functions)
+    {
+        function.print(os);
+        os << std::endl;
+    }
+}
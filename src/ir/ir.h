@@ -0,0 +1,138 @@
+#ifndef SRC_IR_IR_H_
+#define SRC_IR_IR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "common/symbol.h"
+#include "generator/variableslot.h"
+
+class DataTypeBase;
+
+//Three-address code built from the AST once it has been type checked.
+//Every instruction defines at most one value, numbered per function. Values
+//only live within the block that defines them, state that crosses blocks
+//goes through the cells of variables with explicit loads and stores.
+typedef uint32_t IrValue;
+typedef uint32_t IrBlockId;
+
+const IrValue NO_VALUE = UINT32_MAX;
+
+enum class IrOpcode : uint8_t
+{
+    //result = immediate
+    CONSTANT,
+    //result = *slot
+    LOAD,
+    //*slot = operands[0]
+    STORE,
+    //result = operands[0] op operands[1]
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    AND,
+    OR,
+    XOR,
+    SHL,
+    SHR,
+    //result = op operands[0]
+    NEG,
+    NOT,
+    CAST,
+    //result = assembly[immediate](arguments)
+    ASM,
+    //Anything the backend can't generate yet, such as function calls
+    UNIMPLEMENTED
+};
+
+extern const char* IR_OPCODE_NAMES[];
+
+//Instructions that only compute a result from their operands
+bool isOperator(IrOpcode);
+//Binary operators whose operands can be swapped
+bool isCommutative(IrOpcode);
+
+struct IrInstruction
+{
+    IrOpcode opcode;
+    IrValue result;
+    IrValue operands[2];
+    //Type of the result, or of the stored value
+    const DataTypeBase* type;
+    union
+    {
+        uint64_t immediate;
+        //Loads and stores
+        const VariableSlot* slot;
+    };
+};
+
+//Inline assembly with the values it is given on top of the stack. Unless it
+//is pure it may do I/O, so it is never removed.
+struct IrAssembly
+{
+    const std::string* code;
+    std::vector<IrValue> arguments;
+    bool pure;
+};
+
+enum class IrTerminatorKind
+{
+    JUMP,
+    //if/else: targets[0] if the condition is non-zero, targets[1] otherwise,
+    //both end up in merge
+    BRANCH,
+    //Header of a while loop: targets[0] is the body, which jumps back to the
+    //header, targets[1] where the loop exits to
+    LOOP,
+    RETURN
+};
+
+//Control flow is structured, as brainfuck can only express it with nested loops
+struct IrTerminator
+{
+    IrTerminatorKind kind;
+    //Condition of a branch or loop, returned value of a return
+    IrValue value;
+    IrBlockId targets[2];
+    IrBlockId merge;
+};
+
+struct IrBlock
+{
+    std::vector<IrInstruction> instructions;
+    IrTerminator terminator;
+
+    IrBlock();
+};
+
+class IrFunction
+{
+    public:
+        Symbol name;
+        std::vector<IrBlock> blocks;
+        std::vector<IrAssembly> assembly;
+        IrValue value_count;
+        size_t frame_size;
+    public:
+        IrFunction();
+
+        void print(std::ostream&) const;
+};
+
+//Functions are indexed like the scopes of the writer, so the code outside of
+//any function comes first
+class IrProgram
+{
+    public:
+        std::vector<IrFunction> functions;
+    public:
+        void print(std::ostream&) const;
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "ir/valuenumbering.h"
+#include "types/datatype.h"
+
+#include <utility>
+
+ValueNumbering::ValueNumbering():
+    constants(256, Known{NO_VALUE, 0}), epoch(0), instructions_before(0), instructions_after(0) {}
+
+size_t ValueNumbering::getInstructionsBefore() const
+{
+    return this->instructions_before;
+}
+
+size_t ValueNumbering::getInstructionsAfter() const
+{
+    return this->instructions_after;
+}
+
+void ValueNumbering::number(IrProgram& program)
+{
+    for(IrFunction& function : program.functions)
+        this->number(function);
+}
+
+void ValueNumbering::number(IrFunction& function)
+{
+    this->replacements.resize(function.value_count);
+    for(IrValue value = 0; value < function.value_count; ++value)
+        this->replacements[value] = value;
+    this->canonical.resize(function.value_count);
+    for(IrValue value = 0; value < function.value_count; ++value)
+        this->canonical[value] = value;
+
+    //Live ranges are numbered per function
+    this->locals.clear();
+    for(IrBlock& block : function.blocks)
+        this->number(function, block);
+}
+
+void ValueNumbering::replace(IrValue& value) const
+{
+    if(value != NO_VALUE)
+        value = this->replacements[value];
+}
+
+IrValue& ValueNumbering::known(const VariableSlot* slot)
+{
+    std::vector<Known>& variables = slot->global ? this->globals : this->locals;
+    size_t index = slot->global ? slot->offset : slot->live_range;
+    if(index >= variables.size())
+        variables.resize(index + 1, Known{NO_VALUE, 0});
+
+    Known& known = variables[index];
+    if(known.epoch != this->epoch)
+        known = Known{NO_VALUE, this->epoch};
+    return known.value;
+}
+
+ValueNumbering::Expression ValueNumbering::expression(const IrInstruction& instruction) const
+{
+    IrValue lhs = this->canonical[instruction.operands[0]];
+    IrValue rhs = instruction.operands[1];
+    if(rhs != NO_VALUE)
+        rhs = this->canonical[rhs];
+    if(isCommutative(instruction.opcode) && lhs > rhs)
+        std::swap(lhs, rhs);
+    return Expression{instruction.opcode, {lhs, rhs}, instruction.type, instruction.result};
+}
+
+ValueNumbering::Expression& ValueNumbering::find(const Expression& expression)
+{
+    size_t mask = this->expressions.size() - 1;
+    uint64_t hash = (uint64_t) expression.opcode;
+    hash = (hash << 32 | expression.operands[0]) * 0x9E3779B97F4A7C15;
+    hash = (hash ^ expression.operands[1]) * 0x9E3779B97F4A7C15;
+    hash = (hash ^ (uintptr_t) expression.type) * 0x9E3779B97F4A7C15;
+
+    for(size_t i = (hash >> 32) & mask;; i = (i + 1) & mask)
+    {
+        Expression& entry = this->expressions[i];
+        if(entry.value == NO_VALUE)
+            return entry;
+        if(entry.opcode == expression.opcode && entry.type == expression.type &&
+           entry.operands[0] == expression.operands[0] && entry.operands[1] == expression.operands[1])
+        {
+            return entry;
+        }
+    }
+}
+
+void ValueNumbering::number(IrFunction& function, IrBlock& block)
+{
+    std::vector<IrInstruction>& instructions = block.instructions;
+    this->instructions_before += instructions.size();
+
+    //Values don't outlive their block. The table is kept at most half full.
+    this->epoch++;
+    size_t operators = 0;
+    for(const IrInstruction& instruction : instructions)
+        operators += isOperator(instruction.opcode);
+    size_t capacity = 1;
+    while(capacity < operators * 2)
+        capacity *= 2;
+    this->expressions.assign(capacity, Expression{IrOpcode::CONSTANT, {NO_VALUE, NO_VALUE}, nullptr, NO_VALUE});
+
+    for(IrInstruction& instruction : instructions)
+    {
+        if(instruction.opcode == IrOpcode::ASM)
+        {
+            for(IrValue& argument : function.assembly[instruction.immediate].arguments)
+                this->replace(argument);
+        }
+        this->replace(instruction.operands[0]);
+        this->replace(instruction.operands[1]);
+
+        if(isOperator(instruction.opcode))
+        {
+            Expression& entry = this->find(this->expression(instruction));
+            if(entry.value != NO_VALUE)
+                this->replacements[instruction.result] = entry.value;
+            else
+                entry = this->expression(instruction);
+            continue;
+        }
+
+        switch(instruction.opcode)
+        {
+            case IrOpcode::CONSTANT:
+            {
+                if(instruction.type != TypeTable::get<DataTypeClass::U8>() || instruction.immediate >= this->constants.size())
+                    break;
+                Known& constant = this->constants[instruction.immediate];
+                if(constant.epoch != this->epoch || constant.value == NO_VALUE)
+                    constant = Known{instruction.result, this->epoch};
+                this->canonical[instruction.result] = constant.value;
+                break;
+            }
+            case IrOpcode::LOAD:
+            {
+                IrValue& known = this->known(instruction.slot);
+                if(known != NO_VALUE)
+                    this->replacements[instruction.result] = known;
+                else
+                    known = instruction.result;
+                break;
+            }
+            case IrOpcode::STORE:
+                this->known(instruction.slot) = NO_VALUE;
+                break;
+            case IrOpcode::UNIMPLEMENTED:
+                this->epoch++;
+                break;
+            default:
+                break;
+        }
+    }
+    this->replace(block.terminator.value);
+
+    //Drop what was replaced
+    size_t kept = 0;
+    for(size_t i = 0; i < instructions.size(); ++i)
+    {
+        IrValue result = instructions[i].result;
+        if(result == NO_VALUE || this->replacements[result] == result)
+            instructions[kept++] = instructions[i];
+    }
+    instructions.resize(kept);
+
+    this->instructions_after += instructions.size();
+}
@@ -0,0 +1,71 @@
+#ifndef SRC_IR_VALUENUMBERING_H_
+#define SRC_IR_VALUENUMBERING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ir/ir.h"
+
+//Reuses values within a block instead of computing them again. Operators
+//applied to the same values are computed once, and every load of a variable
+//reuses the value last loaded from it, until the variable is stored to or
+//something unimplemented (a call) may have changed it. How a value with
+//several uses is materialized is left to the backend. Equal u8 constants
+//stay separate values, as they are cheap to materialize again, but operators
+//applied to them count as equal.
+class ValueNumbering
+{
+    private:
+        struct Expression
+        {
+            IrOpcode opcode;
+            IrValue operands[2];
+            const DataTypeBase* type;
+            //NO_VALUE for empty entries
+            IrValue value;
+        };
+
+        //Last value loaded from a variable, valid during one epoch
+        struct Known
+        {
+            IrValue value;
+            uint32_t epoch;
+        };
+
+        //What every value was replaced with, itself if it was kept
+        std::vector<IrValue> replacements;
+        //Open addressing table of the expressions of the current block
+        std::vector<Expression> expressions;
+        //First u8 constant of every value in the current block, which stands
+        //for all equal ones in expressions
+        std::vector<Known> constants;
+        std::vector<IrValue> canonical;
+        //Variables by offset for globals and by live range for locals. A new
+        //epoch forgets all of them at once.
+        std::vector<Known> globals;
+        std::vector<Known> locals;
+        uint32_t epoch;
+
+        size_t instructions_before;
+        size_t instructions_after;
+    public:
+        ValueNumbering();
+        ~ValueNumbering() = default;
+
+        void number(IrProgram&);
+        void number(IrFunction&);
+
+        //Instruction counts of everything numbered so far
+        size_t getInstructionsBefore() const;
+        size_t getInstructionsAfter() const;
+    private:
+        void number(IrFunction&, IrBlock&);
+        void replace(IrValue&) const;
+        IrValue& known(const VariableSlot*);
+        Expression expression(const IrInstruction&) const;
+        //The entry of an equal expression, or the empty one to put it in
+        Expression& find(const Expression&);
+};
+
+#endif
@@ -1,46 +1,198 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <memory>
+#include <cstring>
+#include <chrono>
 #include "parser/parser.h"
+#include "parser/sourcefile.h"
 #include "ast/node.h"
+#include "generator/brainfuck.h"
+#include "generator/optimizer.h"
+#include "generator/backend.h"
+#include "ir/ir.h"
+#include "ir/builder.h"
+#include "ir/deadcode.h"
+#include "ir/valuenumbering.h"
+#include "runtime/program.h"
+#include "runtime/interpreter.h"
+#include "runtime/jit.h"
+#include "except/exceptions.h"
 #include "common/util.h"
 #include "common/format.h"
 
-void parse(const char* name)
+struct Options
 {
-    std::ifstream file(name);
+    const char* input = nullptr;
+    bool print_ast = false;
+    bool print_ir = false;
+    bool optimize = false;
+    bool stats = false;
+    bool run = false;
+    bool jit = false;
+    bool layout_search = false;
+};
 
-    if (!file)
+void execute(const std::string& code, const Options& options)
+{
+    Program program(code);
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (options.jit && !JitCompiler::isSupported())
     {
-        fmt::fprintf(std::cerr, "Error: failed to open '", name, "'\n");
-        return;
+        fmt::fprintf(std::cerr, "JIT not supported on this platform, falling back to the interpreter\n");
+    }
+    else if (options.jit)
+    {
+        JitCompiler jit;
+        if (jit.run(program, std::cin, std::cout))
+        {
+            auto end = std::chrono::steady_clock::now();
+            if (options.stats)
+                fmt::fprintf(std::cerr, "Ran native code in ", std::chrono::duration<double>(end - start).count(), "s\n");
+            return;
+        }
+
+        fmt::fprintf(std::cerr, "JIT failed to map native code, falling back to the interpreter\n");
+    }
+
+    Interpreter interpreter;
+    interpreter.run(program, std::cin, std::cout);
+    auto end = std::chrono::steady_clock::now();
+
+    if (options.stats)
+    {
+        double seconds = std::chrono::duration<double>(end - start).count();
+        uint64_t executed = interpreter.getExecutedInstructions();
+        fmt::fprintf(std::cerr, "Executed ", executed, " instructions in ", seconds, "s (",
+            (uint64_t) (executed / seconds), " per second)\n");
     }
+}
 
-    fmt::printf("Parsing ", name, '\n');
+void compile(const Options& options)
+{
+    SourceFile file(options.input);
 
-    Parser p(file);
+    if (!file.isOpen())
+    {
+        fmt::fprintf(std::cerr, "Error: failed to open '", options.input, "'\n");
+        return;
+    }
+
+    Arena arena;
+    Parser p(file.getText(), arena);
 
     try
     {
-        std::unique_ptr<GlobalNode> root = p.program();
-        root->print(std::cout, 0);
+        GlobalNode* root = p.program();
+
+        if (options.print_ast)
+        {
+            fmt::printf("Parsing ", options.input, '\n');
+            root->print(std::cout, 0);
+            std::cout << std::endl;
+            return;
+        }
+
+        std::stringstream code;
+        BrainfuckWriter writer(code);
+        writer.setLayoutSearch(options.layout_search);
+
+        root->declareGlobals(writer);
+        root->checkTypes(writer);
+        if (options.optimize)
+            root->foldConstants(arena);
+
+        IrProgram ir;
+        IrBuilder builder(ir);
+        root->lower(builder);
+
+        ValueNumbering numbering;
+        DeadCodeEliminator eliminator;
+        if (options.optimize)
+        {
+            numbering.number(ir);
+            eliminator.eliminate(ir);
+        }
+
+        if (options.print_ir)
+        {
+            ir.print(std::cout);
+            return;
+        }
+
+        BrainfuckBackend backend(writer);
+        backend.generate(ir);
+        writer.flush();
+
+        std::string program = code.str();
+
+        if (options.stats)
+        {
+            const FrameStatistics& frames = writer.getFrameStatistics();
+            if (options.layout_search)
+                fmt::fprintf(std::cerr, "Pointer moves: ", frames.unsearched_moves, " -> ", frames.moves,
+                    " (", frames.unsearched_moves - frames.moves, " saved)\n");
+            if (options.optimize)
+                fmt::fprintf(std::cerr, "IR instructions: ", numbering.getInstructionsBefore(), " -> ", eliminator.getInstructionsAfter(), '\n');
+        }
+
+        if (options.optimize)
+        {
+            BrainfuckOptimizer optimizer;
+            program = optimizer.optimize(program);
+
+            if (options.stats)
+                fmt::fprintf(std::cerr, "Instructions: ", optimizer.getInstructionsBefore(), " -> ", optimizer.getInstructionsAfter(), '\n');
+        }
+
+        if (options.run || options.jit)
+            execute(program, options);
+        else
+            std::cout << program << std::endl;
     }
     catch (const SyntaxError& err)
     {
-        fmt::fprintf(std::cerr, err.what());
+        fmt::fprintf(std::cerr, err.what(), '\n');
+    }
+    catch (const AlipheeseException& err)
+    {
+        fmt::fprintf(std::cerr, "Error: ", err.what(), '\n');
     }
-    std::cout << std::endl;
 }
 
 int main(int argc, char *argv[])
 {
-    if (argc < 2)
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--ast") == 0)
+            options.print_ast = true;
+        else if (std::strcmp(argv[i], "--ir") == 0)
+            options.print_ir = true;
+        else if (std::strcmp(argv[i], "-O") == 0)
+            options.optimize = true;
+        else if (std::strcmp(argv[i], "--stats") == 0)
+            options.stats = true;
+        else if (std::strcmp(argv[i], "--run") == 0)
+            options.run = true;
+        else if (std::strcmp(argv[i], "--jit") == 0)
+            options.jit = true;
+        else if (std::strcmp(argv[i], "--layout-search") == 0)
+            options.layout_search = true;
+        else
+            options.input = argv[i];
+    }
+
+    if (options.input == nullptr)
     {
-        fmt::fprintf(std::cerr, "Usage: ", argv[0], " <input>\n");
+        fmt::fprintf(std::cerr, "Usage: ", argv[0], " [--ast | --ir] [-O] [--layout-search] [--stats] [--run | --jit] <input>\n");
         return 0;
     }
 
-    parse(argv[1]);
+    compile(options);
 
     return 0;
 }
@@ -1,35 +1,107 @@
 #include "parser/lexer.h"
+#include "parser/scanner.h"
 #include "common/variant.h"
+#include <array>
+#include <charconv>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+
+struct Keyword
+{
+    std::string_view text;
+    TokenType type;
+};
+
+constexpr Keyword KEYWORDS[] = {
+    {"if", TokenType::IF},
+    {"else", TokenType::ELSE},
+    {"while", TokenType::WHILE},
+    {"type", TokenType::TYPE},
+    {"func", TokenType::FUNC},
+    {"return", TokenType::RETURN},
+    {"asm", TokenType::ASM},
+    {"u8", TokenType::U8},
+    {"void", TokenType::VOID},
+    {"as", TokenType::AS}
+};
+
+const size_t KEYWORD_TABLE_SIZE = 16;
+
+// Perfect hash for the keywords above, checked at compile time below
+constexpr size_t keywordHash(std::string_view text)
+{
+    return (text.size() + (unsigned char) text.front() * 10 + (unsigned char) text.back()) % KEYWORD_TABLE_SIZE;
+}
+
+constexpr std::array<Keyword, KEYWORD_TABLE_SIZE> makeKeywordTable()
+{
+    std::array<Keyword, KEYWORD_TABLE_SIZE> table{};
+    for (const Keyword& keyword : KEYWORDS)
+        table[keywordHash(keyword.text)] = keyword;
+    return table;
+}
+
+constexpr std::array<Keyword, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = makeKeywordTable();
+
+constexpr bool isKeywordTablePerfect()
+{
+    for (const Keyword& keyword : KEYWORDS)
+    {
+        if (KEYWORD_TABLE[keywordHash(keyword.text)].text != keyword.text)
+            return false;
+    }
+    return true;
+}
+
+static_assert(isKeywordTablePerfect(), "Keywords collide in the keyword hash");
+
+Lexer::Lexer(std::string_view source):
+    current(source.data()), end(source.data() + source.size()), token_start(source.data()), row(1), col(1) {}
 
 Lexer::Lexer(std::istream& input):
-    input(input), row(1), col(1) {}
+    row(1), col(1)
+{
+    std::stringstream ss;
+    ss << input.rdbuf();
+    this->storage = ss.str();
+    this->current = this->storage.data();
+    this->end = this->storage.data() + this->storage.size();
+    this->token_start = this->current;
+}
 
 Token Lexer::next()
 {
-    this->buffer.clear();
+    this->token_start = this->current;
 
     Span span{this->row, this->col};
     TokenType type = this->nextType();
+    this->buffer = std::string_view(this->token_start, this->current - this->token_start);
 
     return toToken(span, type);
 }
 
+Token Lexer::nextSignificant()
+{
+    this->skipTrivia();
+    return this->next();
+}
+
 int Lexer::consume()
 {
-    int c = this->input.get();
-    this->buffer.append(1, c);
+    if (this->current == this->end)
+        return EOF;
+
+    int c = (unsigned char) *this->current++;
 
-    if (c != EOF)
+    if (c == '\n')
     {
-        if (c == '\n')
-        {
-            this->col = 1;
-            this->row++;
-        }
-        else
-            this->col++;
+        this->col = 1;
+        this->row++;
     }
+    else
+        this->col++;
 
     return c;
 }
@@ -45,21 +117,31 @@ bool Lexer::eat(int c)
     return false;
 }
 
-bool Lexer::eatRange(int low, int high)
+void Lexer::advance(const char* to)
 {
-    if (this->peek() >= low && this->peek() <= high)
-    {
-        this->consume();
-        return true;
-    }
-
-    return false;
+    this->col += to - this->current;
+    this->current = to;
 }
 
 void Lexer::consumeline()
 {
-    while (peek() != '\n')
-        this->consume();
+    this->advance(scanLine(this->current, this->end));
+}
+
+void Lexer::skipTrivia()
+{
+    while (true)
+    {
+        this->advance(scanBlanks(this->current, this->end));
+
+        if (this->eat('\n'))
+            continue;
+
+        if (this->end - this->current >= 2 && this->current[0] == '/' && this->current[1] == '/')
+            this->consumeline();
+        else
+            return;
+    }
 }
 
 TokenType Lexer::nextType()
@@ -97,18 +179,15 @@ TokenType Lexer::nextType()
         case ' ':
         case '\t':
         case '\r':
-            while (this->eat(' ') || this->eat('\t') || this->eat('\r'))
-                continue;
+            this->advance(scanBlanks(this->current, this->end));
             return TokenType::WHITESPACE;
         case 'a' ... 'z':
         case 'A' ... 'Z':
         case '_':
-            while(this->eatRange('a', 'z') || this->eatRange('A', 'Z') || this->eatRange('0', '9') || this->eat('_'))
-                continue;
+            this->advance(scanIdentifier(this->current, this->end));
             return TokenType::IDENT;
         case '0' ... '9':
-            while(this->eatRange('0', '9'))
-                continue;
+            this->advance(scanDigits(this->current, this->end));
             return TokenType::INTEGER;
         default:
             return TokenType::UNKNOWN;
@@ -120,35 +199,22 @@ Token Lexer::toToken(Span span, TokenType type)
     switch (type)
     {
         case TokenType::IDENT:
-            // Too lazy for perfect hash
-            if (this->buffer == "if")
-                return Token(span, TokenType::IF);
-            else if (this->buffer == "else")
-                return Token(span, TokenType::ELSE);
-            else if (this->buffer == "while")
-                return Token(span, TokenType::WHILE);
-            else if (this->buffer == "type")
-                return Token(span, TokenType::TYPE);
-            else if (this->buffer == "func")
-                return Token(span, TokenType::FUNC);
-            else if (this->buffer == "return")
-                return Token(span, TokenType::RETURN);
-            else if (this->buffer == "asm")
-                return Token(span, TokenType::ASM);
-            else if (this->buffer == "u8")
-                return Token(span, TokenType::U8);
-            else if (this->buffer == "void")
-                return Token(span, TokenType::VOID);
-            else if (this->buffer == "as")
-                return Token(span, TokenType::AS);
-            return Token::make<std::string>(span, TokenType::IDENT, buffer);
+        {
+            const Keyword& keyword = KEYWORD_TABLE[keywordHash(this->buffer)];
+            if (keyword.text == this->buffer)
+                return Token(span, keyword.type);
+            return Token::make<std::string_view>(span, TokenType::IDENT, buffer);
+        }
         case TokenType::WHITESPACE:
         case TokenType::COMMENT:
         case TokenType::UNKNOWN:
-            return Token::make<std::string>(span, type, buffer);
+            return Token::make<std::string_view>(span, type, buffer);
         case TokenType::INTEGER:
         {
-            uint64_t x = std::strtoull(buffer.c_str(), nullptr, 10);
+            uint64_t x;
+            // Saturates like strtoull, the parser reports the overflow
+            if (std::from_chars(buffer.data(), buffer.data() + buffer.size(), x).ec != std::errc())
+                x = std::numeric_limits<uint64_t>::max();
             return Token::make<uint64_t>(span, type, x);
         }
         default:
@@ -3,30 +3,43 @@
 
 #include <istream>
 #include <optional>
+#include <string_view>
 #include "parser/token.h"
 
+// Lexes a block of text in memory; lexemes are slices of that text, which
+// therefore has to outlive the tokens.
 class Lexer
 {
     private:
-        std::istream& input;
+        std::string storage;
+        const char* current;
+        const char* end;
+        const char* token_start;
         std::size_t row, col;
-        std::string buffer;
+        std::string_view buffer;
 
     public:
+        Lexer(std::string_view source);
+        // Reads the whole stream up front and keeps it alive itself
         Lexer(std::istream& input);
+        // Every token, whitespace, newlines and comments included
         Token next();
+        // The next token that isn't trivia, which is skipped without building tokens for it
+        Token nextSignificant();
 
     private:
         int peek()
         {
-            return this->input.peek();
+            return this->current != this->end ? (unsigned char) *this->current : EOF;
         }
 
         int consume();
         bool eat(int c);
-        bool eatRange(int low, int high);
+        // Skips to a later point on the same line
+        void advance(const char* to);
 
         void consumeline();
+        void skipTrivia();
 
         TokenType nextType();
         Token toToken(Span span, TokenType type);
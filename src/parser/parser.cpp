@@ -3,7 +3,6 @@
 #include "ast/stat/ifnode.h"
 #include "ast/stat/ifelsenode.h"
 #include "ast/stat/expressionstatementnode.h"
-#include "ast/stat/emptystatement.h"
 #include "ast/stat/statementlistnode.h"
 #include "ast/expr/declarationnode.h"
 #include "ast/expr/functioncallnode.h"
@@ -53,8 +52,14 @@ SyntaxError::SyntaxError(const Span& span, const std::string& msg):
     std::runtime_error(fmt::sprintf("Error at ", span, ": ", msg, "."))
 {}
 
-Parser::Parser(std::istream& input):
-    lexer(input), token(Span{0, 0}, TokenType::EOI)
+Parser::Parser(std::string_view source, Arena& arena):
+    lexer(source), token(Span{0, 0}, TokenType::EOI), arena(arena)
+{
+    consume();
+}
+
+Parser::Parser(std::istream& input, Arena& arena):
+    lexer(input), token(Span{0, 0}, TokenType::EOI), arena(arena)
 {
     consume();
 }
@@ -64,7 +69,7 @@ void Parser::error(const std::string& msg)
     throw SyntaxError(this->token.span, msg);
 }
 
-std::unique_ptr<GlobalNode> Parser::program()
+GlobalNode* Parser::program()
 {
     TRACE;
     return this->prog();
@@ -72,31 +77,24 @@ std::unique_ptr<GlobalNode> Parser::program()
 
 const Token& Parser::consume()
 {
-    do
-       this->token = this->lexer.next();
-    while (this->token.isOneOf<TokenType::WHITESPACE, TokenType::COMMENT, TokenType::NEWLINE>());
-
+    this->token = this->lexer.nextSignificant();
     return this->token;
 }
 
 // <unit> = <globalstat>*
-std::unique_ptr<GlobalNode> Parser::prog()
+GlobalNode* Parser::prog()
 {
     TRACE;
-    std::vector<std::unique_ptr<GlobalElementNode>> elements;
+    std::vector<GlobalElementNode*> elements;
 
     while (!this->check<TokenType::EOI>())
         elements.push_back(globalstat());
 
-    std::vector<GlobalElementNode*> tmp;
-
-    for (auto& elem : elements)
-        tmp.push_back(elem.release());
-    return std::make_unique<GlobalNode>(tmp);
+    return this->arena.create<GlobalNode>(elements);
 }
 
 // <globalstat> = <funcdecl> | <structdecl> | <globalexpr>
-std::unique_ptr<GlobalElementNode> Parser::globalstat()
+GlobalElementNode* Parser::globalstat()
 {
     TRACE;
     if (this->check<TokenType::FUNC>())
@@ -108,63 +106,63 @@ std::unique_ptr<GlobalElementNode> Parser::globalstat()
     return this->globalexpr();
 }
 
-std::unique_ptr<GlobalExpressionNode> Parser::globalexpr()
+GlobalExpressionNode* Parser::globalexpr()
 {
     TRACE;
     auto expr = this->expr();
     this->expect<TokenType::SEMICOLON>();
-    return std::make_unique<GlobalExpressionNode>(expr.release());
+    return this->arena.create<GlobalExpressionNode>(expr);
 }
 
 // <structdecl> = 'type' <id> '{' <fieldlist> '}'
-std::unique_ptr<StructureDefinitionNode> Parser::structdecl()
+StructureDefinitionNode* Parser::structdecl()
 {
     TRACE;
     this->expect<TokenType::TYPE>();
 
-    const std::string name = this->ident();
+    Symbol name = this->ident();
 
     this->expect<TokenType::BRACE_OPEN>();
 
     if (this->eat<TokenType::BRACE_CLOSE>())
-        return std::make_unique<StructureDefinitionNode>(name, new FieldListNode(std::vector<Field>()));
+        return this->arena.create<StructureDefinitionNode>(name, this->arena.create<FieldListNode>(std::vector<Field>()));
 
     auto members = fieldlist();
 
     this->expect<TokenType::BRACE_CLOSE>();
 
-    return std::make_unique<StructureDefinitionNode>(name, members.release());
+    return this->arena.create<StructureDefinitionNode>(name, members);
 }
 
 // <funcdecl> = 'func' <id> <funcpar> ('->' <id>)? <block>
-std::unique_ptr<FunctionDeclaration> Parser::funcdecl()
+FunctionDeclaration* Parser::funcdecl()
 {
     TRACE;
     this->expect<TokenType::FUNC>();
-    const std::string name = this->ident();
+    Symbol name = this->ident();
 
     auto parameters = funcpar();
 
-    std::unique_ptr<DataTypeBase> rtype(nullptr);
+    const DataTypeBase* rtype;
 
     if (this->eat<TokenType::ARROW>())
         rtype = this->datatype();
     else
-        rtype = std::make_unique<DataType<DataTypeClass::VOID>>();
+        rtype = TypeTable::get<DataTypeClass::VOID>();
 
     auto body = block();
 
-    return std::make_unique<FunctionDeclaration>(name, parameters.release(), rtype.release(), body.release());
+    return this->arena.create<FunctionDeclaration>(name, parameters, rtype, body);
 }
 
 // <funcpar> = '(' <fieldlist>? ')'
-std::unique_ptr<FieldListNode> Parser::funcpar()
+FieldListNode* Parser::funcpar()
 {
     TRACE;
     this->expect<TokenType::PAREN_OPEN>();
 
     if (this->eat<TokenType::PAREN_CLOSE>())
-        return std::make_unique<FieldListNode>(std::vector<Field>());
+        return this->arena.create<FieldListNode>(std::vector<Field>());
 
     auto parameters = fieldlist();
     this->expect<TokenType::PAREN_CLOSE>();
@@ -172,15 +170,15 @@ std::unique_ptr<FieldListNode> Parser::funcpar()
 }
 
 // <fieldlist> = <type> <id> (',' <type>? <id>)*
-std::unique_ptr<FieldListNode> Parser::fieldlist()
+FieldListNode* Parser::fieldlist()
 {
     TRACE;
     std::vector<Field> parameters;
 
     auto lasttype = datatype();
-    const std::string name = this->ident();
+    Symbol name = this->ident();
 
-    parameters.push_back(Field(lasttype->copy(), name));
+    parameters.push_back(Field(lasttype, name));
 
     while (true)
     {
@@ -194,38 +192,35 @@ std::unique_ptr<FieldListNode> Parser::fieldlist()
 
         if (this->check<TokenType::IDENT>())
         {
-            std::string name = this->ident();
+            Symbol name = this->ident();
             lasttype = saved.asDataType();
-            parameters.push_back(Field(lasttype->copy(), name));
+            parameters.push_back(Field(lasttype, name));
         }
         else
         {
-            std::string name = saved.lexeme.get<std::string>();
-            parameters.push_back(Field(lasttype->copy(), name));
+            Symbol name = Symbol::intern(saved.lexeme.get<std::string_view>());
+            parameters.push_back(Field(lasttype, name));
         }
     }
 
-    return std::make_unique<FieldListNode>(parameters);
+    return this->arena.create<FieldListNode>(parameters);
 }
 
 // <block> = '{' <statement>* '}'
-std::unique_ptr<BlockNode> Parser::block()
+BlockNode* Parser::block()
 {
     TRACE;
-    std::unique_ptr<StatementNode> list = std::make_unique<EmptyStatementNode>();
+    std::vector<StatementNode*> statements;
     this->expect<TokenType::BRACE_OPEN>();
 
     while (!this->eat<TokenType::BRACE_CLOSE>())
-    { 
-        auto node = statement();
-        list = std::make_unique<StatementListNode>(list.release(), node.release());
-    }
+        statements.push_back(statement());
 
-    return std::make_unique<BlockNode>(list.release());
+    return this->arena.create<BlockNode>(this->arena.create<StatementListNode>(statements));
 }
 
 // <statement> = <ifstat> | <whilestat>
-std::unique_ptr<StatementNode> Parser::statement()
+StatementNode* Parser::statement()
 {
     TRACE;
     if (this->check<TokenType::IF>())
@@ -243,26 +238,26 @@ std::unique_ptr<StatementNode> Parser::statement()
     return this->exprstat();
 }
 
-std::unique_ptr<ReturnNode> Parser::returnstat()
+ReturnNode* Parser::returnstat()
 {
     TRACE;
     this->expect<TokenType::RETURN>();
     auto expr = this->expr();
-    return std::make_unique<ReturnNode>(expr.release());
+    return this->arena.create<ReturnNode>(expr);
 }
 
-std::unique_ptr<StatementNode> Parser::exprstat()
+StatementNode* Parser::exprstat()
 {
     TRACE;
     auto expr = this->expr();
 
     if (this->eat<TokenType::SEMICOLON>())
-        return std::make_unique<ExpressionStatementNode>(expr.release());
-    return std::make_unique<ReturnNode>(expr.release());
+        return this->arena.create<ExpressionStatementNode>(expr);
+    return this->arena.create<ReturnNode>(expr);
 }
 
 // <ifstat> = 'if' <expr> <block> ('else' (<ifstat> | <block>))?
-std::unique_ptr<StatementNode> Parser::ifstat()
+StatementNode* Parser::ifstat()
 {
     TRACE;
     this->expect<TokenType::IF>();
@@ -273,14 +268,14 @@ std::unique_ptr<StatementNode> Parser::ifstat()
     if (this->eat<TokenType::ELSE>())
     {
         auto alternative = block();
-        return std::make_unique<IfElseNode>(condition.release(), consequent.release(), alternative.release());
+        return this->arena.create<IfElseNode>(condition, consequent, alternative);
     }
 
-    return std::make_unique<IfNode>(condition.release(), consequent.release());
+    return this->arena.create<IfNode>(condition, consequent);
 }
 
 // <whilestat> = 'while' <expr> <block>
-std::unique_ptr<WhileNode> Parser::whilestat()
+WhileNode* Parser::whilestat()
 {
     TRACE;
     this->expect<TokenType::WHILE>();
@@ -288,17 +283,17 @@ std::unique_ptr<WhileNode> Parser::whilestat()
     auto condition = expr();
     auto consequent = block();
 
-    return std::make_unique<WhileNode>(condition.release(), consequent.release());
+    return this->arena.create<WhileNode>(condition, consequent);
 }
 
 // <expr> = <sum>
-std::unique_ptr<ExpressionNode> Parser::expr()
+ExpressionNode* Parser::expr()
 {
     TRACE;
     return this->cast();
 }
 
-std::unique_ptr<ExpressionNode> Parser::cast() 
+ExpressionNode* Parser::cast() 
 {
     auto expr = this->bor();
     if (!this->eat<TokenType::AS>())
@@ -306,10 +301,10 @@ std::unique_ptr<ExpressionNode> Parser::cast()
 
     auto type = this->datatype();
 
-    return std::make_unique<CastExpressionNode>(expr.release(), type.release());
+    return this->arena.create<CastExpressionNode>(expr, type);
 }
 
-std::unique_ptr<ExpressionNode> Parser::bor()
+ExpressionNode* Parser::bor()
 {
     TRACE;
     auto lhs = this->bxor();
@@ -320,13 +315,13 @@ std::unique_ptr<ExpressionNode> Parser::bor()
             break;
 
         auto rhs = this->bxor();
-        lhs = std::make_unique<BitwiseOrNode>(lhs.release(), rhs.release());
+        lhs = this->arena.create<BitwiseOrNode>(lhs, rhs);
     }
 
     return lhs;
 }
 
-std::unique_ptr<ExpressionNode> Parser::bxor()
+ExpressionNode* Parser::bxor()
 {
     TRACE;
     auto lhs = this->band();
@@ -337,13 +332,13 @@ std::unique_ptr<ExpressionNode> Parser::bxor()
             break;
 
         auto rhs = this->band();
-        lhs = std::make_unique<BitwiseXorNode>(lhs.release(), rhs.release());
+        lhs = this->arena.create<BitwiseXorNode>(lhs, rhs);
     }
 
     return lhs;
 }
 
-std::unique_ptr<ExpressionNode> Parser::band()
+ExpressionNode* Parser::band()
 {
     TRACE;
     auto lhs = this->shift();
@@ -354,13 +349,13 @@ std::unique_ptr<ExpressionNode> Parser::band()
             break;
 
         auto rhs = this->shift();
-        lhs = std::make_unique<BitwiseAndNode>(lhs.release(), rhs.release());
+        lhs = this->arena.create<BitwiseAndNode>(lhs, rhs);
     }
 
     return lhs;
 }
 
-std::unique_ptr<ExpressionNode> Parser::shift()
+ExpressionNode* Parser::shift()
 {
     TRACE;
     auto lhs = this->sum();
@@ -372,14 +367,14 @@ std::unique_ptr<ExpressionNode> Parser::shift()
             break;
 
         auto rhs = this->sum();
-        lhs = this->toBinOp(optype, std::move(lhs), std::move(rhs));
+        lhs = this->toBinOp(optype, lhs, rhs);
     }
 
     return lhs;
 }
 
 // <sum> = <product> (('+' | '-') <product>)*
-std::unique_ptr<ExpressionNode> Parser::sum()
+ExpressionNode* Parser::sum()
 {
     TRACE;
     auto lhs = this->product();
@@ -391,14 +386,14 @@ std::unique_ptr<ExpressionNode> Parser::sum()
             break;
 
         auto rhs = this->product();
-        lhs = this->toBinOp(optype, std::move(lhs), std::move(rhs));
+        lhs = this->toBinOp(optype, lhs, rhs);
     }
 
     return lhs;
 }
 
 // <product> = <unary> (('*' | '/' | '%') <unary>)*
-std::unique_ptr<ExpressionNode> Parser::product()
+ExpressionNode* Parser::product()
 {
     TRACE;
     auto lhs = this->unary();
@@ -410,23 +405,23 @@ std::unique_ptr<ExpressionNode> Parser::product()
             break;
 
         auto rhs = this->unary();
-        lhs = this->toBinOp(optype, std::move(lhs), std::move(rhs));
+        lhs = this->toBinOp(optype, lhs, rhs);
     }
 
     return lhs;
 }
 
 // <unary> = '-' <unary> | <atom>
-std::unique_ptr<ExpressionNode> Parser::unary()
+ExpressionNode* Parser::unary()
 {
     TRACE;
     if (this->eat<TokenType::MINUS>())
-        return std::make_unique<NegateNode>(this->unary().release());
+        return this->arena.create<NegateNode>(this->unary());
     return this->atom();
 }
 
 // <atom> = <paren> | <constant> | <id> (<funcargs> | <id>? '=' <expr>)?
-std::unique_ptr<ExpressionNode> Parser::atom()
+ExpressionNode* Parser::atom()
 {
     TRACE;
     switch(this->token.type)
@@ -443,23 +438,23 @@ std::unique_ptr<ExpressionNode> Parser::atom()
 }
 
 // <paren> = '(' <expr> ')'
-std::unique_ptr<ExpressionNode> Parser::paren()
+ExpressionNode* Parser::paren()
 {
     TRACE;
     this->expect<TokenType::PAREN_OPEN>();
-    auto node = std::unique_ptr<ExpressionNode>(expr());
+    auto node = expr();
     this->expect<TokenType::PAREN_CLOSE>();
     return node;
 }
 
 // <funcargs> = '(' (<expr> (',' <expr>)*) ')'
-std::unique_ptr<ArgumentListNode> Parser::funcargs()
+ArgumentListNode* Parser::funcargs()
 {
     TRACE;
     this->expect<TokenType::PAREN_OPEN>();
 
     if (this->eat<TokenType::PAREN_CLOSE>())
-        return std::make_unique<ArgumentListNode>(std::vector<ExpressionNode*>());
+        return this->arena.create<ArgumentListNode>(std::vector<ExpressionNode*>());
 
     auto args = arglist();
     this->expect<TokenType::PAREN_CLOSE>();
@@ -467,26 +462,21 @@ std::unique_ptr<ArgumentListNode> Parser::funcargs()
 }
 
 // <arglist> = <expr> (',' <expr>)*
-std::unique_ptr<ArgumentListNode> Parser::arglist()
+ArgumentListNode* Parser::arglist()
 {
     TRACE;
-    std::vector<std::unique_ptr<ExpressionNode>> arguments;
+    std::vector<ExpressionNode*> arguments;
 
     while (true)
     {
         arguments.push_back(this->expr());
 
         if (!this->eat<TokenType::COMMA>())
-        {
-            std::vector<ExpressionNode*> tmp;
-            for (auto& arg : arguments)
-                tmp.push_back(arg.release());
-            return std::make_unique<ArgumentListNode>(tmp);
-        }
+            return this->arena.create<ArgumentListNode>(arguments);
     }
 }
 
-std::unique_ptr<ExpressionNode> Parser::variable()
+ExpressionNode* Parser::variable()
 {
     TRACE;
     if (!this->token.isDataType()) // also includes isType<IDENT>
@@ -500,19 +490,19 @@ std::unique_ptr<ExpressionNode> Parser::variable()
         case TokenType::PAREN_OPEN:
         {
             auto args = this->funcargs();
-            return std::make_unique<FunctionCallNode>(saved.lexeme.get<std::string>(), args.release());
+            return this->arena.create<FunctionCallNode>(Symbol::intern(saved.lexeme.get<std::string_view>()), args);
         }
         case TokenType::IDENT:
         {
-            std::string name = this->token.lexeme.get<std::string>();
+            Symbol name = Symbol::intern(this->token.lexeme.get<std::string_view>());
             this->consume();
 
-            auto decl = std::make_unique<DeclarationNode>(saved.asDataType().release(), name);
+            auto decl = this->arena.create<DeclarationNode>(saved.asDataType(), name);
 
             if (this->eat<TokenType::EQUALS>())
             {
                 auto rhs = this->expr();
-                return std::make_unique<AssignmentNode>(decl.release(), rhs.release());
+                return this->arena.create<AssignmentNode>(decl, rhs);
             }
 
             return decl;
@@ -521,25 +511,25 @@ std::unique_ptr<ExpressionNode> Parser::variable()
         {
             this->consume();
             auto rhs = this->expr();
-            VariableNode* name = new VariableNode(saved.lexeme.get<std::string>());
-            return std::make_unique<AssignmentNode>(name, rhs.release());
+            VariableNode* name = this->arena.create<VariableNode>(Symbol::intern(saved.lexeme.get<std::string_view>()));
+            return this->arena.create<AssignmentNode>(name, rhs);
         }
         default:
-            return std::make_unique<VariableNode>(saved.lexeme.get<std::string>());
+            return this->arena.create<VariableNode>(Symbol::intern(saved.lexeme.get<std::string_view>()));
     }
 }
 
-std::unique_ptr<ExpressionNode> Parser::rvalue()
+ExpressionNode* Parser::rvalue()
 {
     TRACE;
 }
 
-std::unique_ptr<ExpressionNode> Parser::lvalue()
+ExpressionNode* Parser::lvalue()
 {
     TRACE;
 }
 
-std::unique_ptr<ExpressionNode> Parser::constant()
+ExpressionNode* Parser::constant()
 {
     TRACE;
     if (!this->check<TokenType::INTEGER>())
@@ -549,16 +539,20 @@ std::unique_ptr<ExpressionNode> Parser::constant()
     this->consume();
 
     if (x <= (1 << 8) -1)
-        return std::make_unique<U8ConstantNode>((uint8_t) (x & 0xFF));
+        return this->arena.create<U8ConstantNode>((uint8_t) (x & 0xFF));
 
     this->error(fmt::sprintf("value of ", x, "overflowed"));
     return nullptr;
 }
 
-std::unique_ptr<AssemblyNode> Parser::assembly()
+AssemblyNode* Parser::assembly()
 {
     TRACE;
     this->expect<TokenType::ASM>();
+    // "pure" is only special right after asm, so it stays usable as a name
+    bool pure = this->check<TokenType::IDENT>() && this->token.lexeme.get<std::string_view>() == "pure";
+    if (pure)
+        this->consume();
     auto args = this->funcargs();
     this->expect<TokenType::ARROW>();
     auto returntype = this->datatype();
@@ -566,7 +560,7 @@ std::unique_ptr<AssemblyNode> Parser::assembly()
     std::string code = this->brainfuck();
     this->expect<TokenType::BRACE_CLOSE>();
 
-    return std::make_unique<AssemblyNode>(returntype.release(), code, args.release());
+    return this->arena.create<AssemblyNode>(returntype, code, args, pure);
 }
 
 std::string Parser::brainfuck()
@@ -620,7 +614,7 @@ std::string Parser::brainfuck()
     }
 }
 
-std::unique_ptr<DataTypeBase> Parser::datatype()
+const DataTypeBase* Parser::datatype()
 {
     if (!this->token.isDataType())
         this->expected("datatype");
@@ -629,43 +623,43 @@ std::unique_ptr<DataTypeBase> Parser::datatype()
     return dt;
 }
 
-std::string Parser::ident()
+Symbol Parser::ident()
 {
     if (!this->check<TokenType::IDENT>())
         this->expected(TokenType::IDENT);
 
-    std::string ident = this->token.lexeme.get<std::string>();
+    Symbol ident = Symbol::intern(this->token.lexeme.get<std::string_view>());
     this->consume();
     return ident;
 }
 
-std::unique_ptr<ExpressionNode> Parser::toBinOp(
+ExpressionNode* Parser::toBinOp(
     TokenType type,
-    std::unique_ptr<ExpressionNode> lhs,
-    std::unique_ptr<ExpressionNode> rhs)
+    ExpressionNode* lhs,
+    ExpressionNode* rhs)
 {
     switch (type)
     {
         case TokenType::PLUS:
-            return std::make_unique<AddNode>(lhs.release(), rhs.release());
+            return this->arena.create<AddNode>(lhs, rhs);
         case TokenType::MINUS:
-            return std::make_unique<SubNode>(lhs.release(), rhs.release());
+            return this->arena.create<SubNode>(lhs, rhs);
         case TokenType::STAR:
-            return std::make_unique<MulNode>(lhs.release(), rhs.release());
+            return this->arena.create<MulNode>(lhs, rhs);
         case TokenType::SLASH:
-            return std::make_unique<DivNode>(lhs.release(), rhs.release());
+            return this->arena.create<DivNode>(lhs, rhs);
         case TokenType::PERCENT:
-            return std::make_unique<ModNode>(lhs.release(), rhs.release());
+            return this->arena.create<ModNode>(lhs, rhs);
         case TokenType::AMPERSAND:
-            return std::make_unique<BitwiseAndNode>(lhs.release(), rhs.release());
+            return this->arena.create<BitwiseAndNode>(lhs, rhs);
         case TokenType::PIPE:
-            return std::make_unique<BitwiseOrNode>(lhs.release(), rhs.release());
+            return this->arena.create<BitwiseOrNode>(lhs, rhs);
         case TokenType::LEFTLEFT:
-            return std::make_unique<BitwiseLeftShiftNode>(lhs.release(), rhs.release());
+            return this->arena.create<BitwiseLeftShiftNode>(lhs, rhs);
         case TokenType::RIGHTRIGHT:
-            return std::make_unique<BitwiseRightShiftNode>(lhs.release(), rhs.release());
+            return this->arena.create<BitwiseRightShiftNode>(lhs, rhs);
         case TokenType::HAT:
-            return std::make_unique<BitwiseXorNode>(lhs.release(), rhs.release());
+            return this->arena.create<BitwiseXorNode>(lhs, rhs);
         default:
             throw std::runtime_error("internal error");
     }
@@ -7,6 +7,7 @@
 #include <memory>
 #include <stdexcept>
 #include "parser/lexer.h"
+#include "common/arena.h"
 #include "ast/argumentlistnode.h"
 #include "ast/fieldlistnode.h"
 #include "ast/global/globalnode.h"
@@ -31,10 +32,13 @@ class Parser
     private:
         Lexer lexer;
         Token token;
+        Arena& arena;
 
     public:
-        Parser(std::istream& input);
-        std::unique_ptr<GlobalNode> program();
+        //Nodes are allocated from the arena and live as long as it does
+        Parser(std::string_view source, Arena& arena);
+        Parser(std::istream& input, Arena& arena);
+        GlobalNode* program();
 
     private:
         void error(const std::string& msg);
@@ -82,48 +86,48 @@ class Parser
                 return this->eat<H>() || this->eatOneOf<T...>();
         }
 
-        std::unique_ptr<GlobalNode> prog();
-        std::unique_ptr<GlobalElementNode> globalstat();
-        std::unique_ptr<GlobalExpressionNode> globalexpr();
-
-        std::unique_ptr<StructureDefinitionNode> structdecl();
-        std::unique_ptr<FunctionDeclaration> funcdecl();
-        std::unique_ptr<FieldListNode> funcpar();
-        std::unique_ptr<FieldListNode> fieldlist();
-
-        std::unique_ptr<BlockNode> block();
-
-        std::unique_ptr<StatementNode> statement();
-        std::unique_ptr<ReturnNode> returnstat();
-        std::unique_ptr<StatementNode> exprstat();
-        std::unique_ptr<StatementNode> ifstat();
-        std::unique_ptr<WhileNode> whilestat();
-
-        std::unique_ptr<ExpressionNode> expr();
-        std::unique_ptr<ExpressionNode> cast();
-        std::unique_ptr<ExpressionNode> bor();
-        std::unique_ptr<ExpressionNode> bxor();
-        std::unique_ptr<ExpressionNode> band();
-        std::unique_ptr<ExpressionNode> shift();
-        std::unique_ptr<ExpressionNode> sum();
-        std::unique_ptr<ExpressionNode> product();
-        std::unique_ptr<ExpressionNode> unary();
-        std::unique_ptr<ExpressionNode> atom();
-        std::unique_ptr<ExpressionNode> paren();
-        std::unique_ptr<ArgumentListNode> funcargs();
-        std::unique_ptr<ArgumentListNode> arglist();
-        std::unique_ptr<ExpressionNode> variable();
-        std::unique_ptr<ExpressionNode> rvalue();
-        std::unique_ptr<ExpressionNode> lvalue();
-        std::unique_ptr<ExpressionNode> constant();
-        std::unique_ptr<AssemblyNode> assembly();
+        GlobalNode* prog();
+        GlobalElementNode* globalstat();
+        GlobalExpressionNode* globalexpr();
+
+        StructureDefinitionNode* structdecl();
+        FunctionDeclaration* funcdecl();
+        FieldListNode* funcpar();
+        FieldListNode* fieldlist();
+
+        BlockNode* block();
+
+        StatementNode* statement();
+        ReturnNode* returnstat();
+        StatementNode* exprstat();
+        StatementNode* ifstat();
+        WhileNode* whilestat();
+
+        ExpressionNode* expr();
+        ExpressionNode* cast();
+        ExpressionNode* bor();
+        ExpressionNode* bxor();
+        ExpressionNode* band();
+        ExpressionNode* shift();
+        ExpressionNode* sum();
+        ExpressionNode* product();
+        ExpressionNode* unary();
+        ExpressionNode* atom();
+        ExpressionNode* paren();
+        ArgumentListNode* funcargs();
+        ArgumentListNode* arglist();
+        ExpressionNode* variable();
+        ExpressionNode* rvalue();
+        ExpressionNode* lvalue();
+        ExpressionNode* constant();
+        AssemblyNode* assembly();
         std::string brainfuck();
-        std::unique_ptr<DataTypeBase> datatype();
-        std::string ident();
-        std::unique_ptr<ExpressionNode> toBinOp(
+        const DataTypeBase* datatype();
+        Symbol ident();
+        ExpressionNode* toBinOp(
             TokenType type,
-            std::unique_ptr<ExpressionNode> lhs,
-            std::unique_ptr<ExpressionNode> rhs);
+            ExpressionNode* lhs,
+            ExpressionNode* rhs);
 };
 
 #endif
@@ -0,0 +1,251 @@
+#include "parser/scanner.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_AVAILABLE
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// A character class is a scalar membership test plus, where SIMD is
+// available, the same test on 16 and 32 characters at once giving 0xFF for
+// members and 0x00 for everything else.
+struct Blanks
+{
+    static bool contains(unsigned char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+#ifdef SIMD_AVAILABLE
+    static __m128i match(__m128i c)
+    {
+        __m128i space = _mm_cmpeq_epi8(c, _mm_set1_epi8(' '));
+        __m128i tab = _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'));
+        __m128i cr = _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'));
+        return _mm_or_si128(space, _mm_or_si128(tab, cr));
+    }
+
+    AVX2_TARGET static __m256i match(__m256i c)
+    {
+        __m256i space = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' '));
+        __m256i tab = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t'));
+        __m256i cr = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r'));
+        return _mm256_or_si256(space, _mm256_or_si256(tab, cr));
+    }
+#endif
+};
+
+// Ranges are tested as (c - low) <= (high - low) unsigned, which SSE2 can
+// only do as min(x, bound) == x.
+struct IdentifierCharacters
+{
+    static bool contains(unsigned char c)
+    {
+        return (unsigned char) ((c | 0x20) - 'a') < 26 || (unsigned char) (c - '0') < 10 || c == '_';
+    }
+
+#ifdef SIMD_AVAILABLE
+    static __m128i match(__m128i c)
+    {
+        // Setting bit 5 folds upper case onto lower case and nothing else onto letters
+        __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(25)), letter);
+        __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        __m128i underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+        return _mm_or_si128(letter, _mm_or_si128(digit, underscore));
+    }
+
+    AVX2_TARGET static __m256i match(__m256i c)
+    {
+        __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(25)), letter);
+        __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+        __m256i underscore = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_'));
+        return _mm256_or_si256(letter, _mm256_or_si256(digit, underscore));
+    }
+#endif
+};
+
+struct Digits
+{
+    static bool contains(unsigned char c)
+    {
+        return (unsigned char) (c - '0') < 10;
+    }
+
+#ifdef SIMD_AVAILABLE
+    static __m128i match(__m128i c)
+    {
+        __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        return _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    }
+
+    AVX2_TARGET static __m256i match(__m256i c)
+    {
+        __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    }
+#endif
+};
+
+struct LineCharacters
+{
+    static bool contains(unsigned char c)
+    {
+        return c != '\n';
+    }
+
+#ifdef SIMD_AVAILABLE
+    static __m128i match(__m128i c)
+    {
+        return _mm_xor_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')), _mm_set1_epi8(-1));
+    }
+
+    AVX2_TARGET static __m256i match(__m256i c)
+    {
+        return _mm256_xor_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')), _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+template <typename Class>
+const char* scanScalar(const char* begin, const char* end)
+{
+    while (begin != end && Class::contains(*begin))
+        begin++;
+    return begin;
+}
+
+#ifdef SIMD_AVAILABLE
+// Only whole vectors are loaded, the source may end right at a page boundary
+template <typename Class>
+const char* scanSse2(const char* begin, const char* end)
+{
+    while (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) begin);
+        uint32_t outside = ~(uint32_t) _mm_movemask_epi8(Class::match(chunk)) & 0xFFFF;
+        if (outside != 0)
+            return begin + __builtin_ctz(outside);
+        begin += 16;
+    }
+    return scanScalar<Class>(begin, end);
+}
+
+// Most runs are short, so one SSE2 step goes first
+template <typename Class>
+AVX2_TARGET const char* scanAvx2(const char* begin, const char* end)
+{
+    if (end - begin >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) begin);
+        uint32_t outside = ~(uint32_t) _mm_movemask_epi8(Class::match(chunk)) & 0xFFFF;
+        if (outside != 0)
+            return begin + __builtin_ctz(outside);
+        begin += 16;
+    }
+
+    while (end - begin >= 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) begin);
+        uint32_t outside = ~(uint32_t) _mm256_movemask_epi8(Class::match(chunk));
+        if (outside != 0)
+            return begin + __builtin_ctz(outside);
+        begin += 32;
+    }
+    return scanSse2<Class>(begin, end);
+}
+#endif
+
+typedef const char* (*ScanFunction)(const char*, const char*);
+
+struct Scanners
+{
+    ScanFunction blanks;
+    ScanFunction identifier;
+    ScanFunction digits;
+    ScanFunction line;
+};
+
+template <template <typename> class Scan>
+constexpr Scanners makeScanners()
+{
+    return Scanners{Scan<Blanks>::run, Scan<IdentifierCharacters>::run, Scan<Digits>::run, Scan<LineCharacters>::run};
+}
+
+template <typename Class>
+struct ScalarScan
+{
+    static const char* run(const char* begin, const char* end)
+    {
+        return scanScalar<Class>(begin, end);
+    }
+};
+
+#ifdef SIMD_AVAILABLE
+template <typename Class>
+struct Sse2Scan
+{
+    static const char* run(const char* begin, const char* end)
+    {
+        return scanSse2<Class>(begin, end);
+    }
+};
+
+template <typename Class>
+struct Avx2Scan
+{
+    AVX2_TARGET static const char* run(const char* begin, const char* end)
+    {
+        return scanAvx2<Class>(begin, end);
+    }
+};
+#endif
+
+static Scanners selectScanners()
+{
+#ifdef SIMD_AVAILABLE
+    // SSE2 is part of x86-64 itself, AVX2 has to be asked for
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return makeScanners<Avx2Scan>();
+    return makeScanners<Sse2Scan>();
+#else
+    return makeScanners<ScalarScan>();
+#endif
+}
+
+static const Scanners SCANNERS = selectScanners();
+
+// Runs of a single character are common enough to skip the call for
+template <typename Class>
+inline const char* scan(ScanFunction function, const char* begin, const char* end)
+{
+    if (begin == end || !Class::contains(*begin))
+        return begin;
+    return function(begin + 1, end);
+}
+
+const char* scanBlanks(const char* begin, const char* end)
+{
+    return scan<Blanks>(SCANNERS.blanks, begin, end);
+}
+
+const char* scanIdentifier(const char* begin, const char* end)
+{
+    return scan<IdentifierCharacters>(SCANNERS.identifier, begin, end);
+}
+
+const char* scanDigits(const char* begin, const char* end)
+{
+    return scan<Digits>(SCANNERS.digits, begin, end);
+}
+
+const char* scanLine(const char* begin, const char* end)
+{
+    return scan<LineCharacters>(SCANNERS.line, begin, end);
+}
@@ -0,0 +1,20 @@
+#ifndef SRC_PARSER_SCANNER_H_
+#define SRC_PARSER_SCANNER_H_
+
+// Character class scanners for the lexer's hot loops. Each one returns the
+// first character in [begin, end) outside of its class, or end. They use
+// SSE2 or AVX2 where available, picked once at runtime, and plain loops
+// otherwise.
+
+// Spaces, tabs and carriage returns; newlines are tokens of their own
+const char* scanBlanks(const char* begin, const char* end);
+
+// Letters, digits and underscores
+const char* scanIdentifier(const char* begin, const char* end);
+
+const char* scanDigits(const char* begin, const char* end);
+
+// Everything up to the next newline
+const char* scanLine(const char* begin, const char* end);
+
+#endif
@@ -0,0 +1,67 @@
+#include "parser/sourcefile.h"
+
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__)
+#define MMAP_AVAILABLE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SourceFile::SourceFile(const std::string& path):
+    data(nullptr), size(0), mapped(false)
+{
+#ifdef MMAP_AVAILABLE
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    // Empty files can't be mapped, and neither can pipes and the like
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void* memory = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (memory != MAP_FAILED)
+        {
+            madvise(memory, info.st_size, MADV_SEQUENTIAL);
+            this->data = static_cast<const char*>(memory);
+            this->size = info.st_size;
+            this->mapped = true;
+            close(fd);
+            return;
+        }
+    }
+    close(fd);
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return;
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+    this->contents = ss.str();
+    this->data = this->contents.data();
+    this->size = this->contents.size();
+}
+
+SourceFile::~SourceFile()
+{
+#ifdef MMAP_AVAILABLE
+    if (this->mapped)
+        munmap(const_cast<char*>(this->data), this->size);
+#endif
+}
+
+bool SourceFile::isOpen() const
+{
+    return this->data != nullptr;
+}
+
+std::string_view SourceFile::getText() const
+{
+    return std::string_view(this->data, this->size);
+}
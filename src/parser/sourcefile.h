@@ -0,0 +1,29 @@
+#ifndef SRC_PARSER_SOURCEFILE_H_
+#define SRC_PARSER_SOURCEFILE_H_
+
+#include <string>
+#include <string_view>
+
+// Contents of a source file, memory-mapped where the platform allows and read
+// into memory otherwise. Lexemes point straight into the text, so it has to
+// outlive every token lexed from it.
+class SourceFile
+{
+    private:
+        const char* data;
+        std::size_t size;
+        bool mapped;
+        std::string contents;
+
+    public:
+        SourceFile(const std::string& path);
+        SourceFile(const SourceFile&) = delete;
+        ~SourceFile();
+
+        SourceFile& operator=(const SourceFile&) = delete;
+
+        bool isOpen() const;
+        std::string_view getText() const;
+};
+
+#endif
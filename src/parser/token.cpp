@@ -9,7 +9,7 @@ const std::vector<const char*> Token::types =
     "{", "}", "(", ")", "[", "]",
     "->", ",", ".", "=", "+", "-", "*", "/", "%", ";", "<", ">", "<=", ">=",
     "&", "|", "<<", ">>", "^",
-    "if", "else", "while", "type", "func", "return", "asm",
+    "if", "else", "while", "type", "func", "return", "asm", "as",
     "u8", "void"
 };
 
@@ -49,18 +49,18 @@ bool Token::isDataType() const
     return this->isBuiltinDataType() || this->isType<TokenType::IDENT>();
 }
 
-std::unique_ptr<DataTypeBase> Token::asDataType()
+const DataTypeBase* Token::asDataType()
 {
     if (!this->isDataType())
         return nullptr;
 
     switch (this->type) {
         case TokenType::U8:
-            return std::make_unique<DataType<DataTypeClass::U8>>();
+            return TypeTable::get<DataTypeClass::U8>();
         case TokenType::VOID:
-            return std::make_unique<DataType<DataTypeClass::VOID>>();
+            return TypeTable::get<DataTypeClass::VOID>();
         default:
-            return std::make_unique<DataType<DataTypeClass::STRUCT_FORWARD>>(this->lexeme.get<std::string>());
+            return TypeTable::getStructure(Symbol::intern(this->lexeme.get<std::string_view>()));
     }
 }
 
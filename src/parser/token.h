@@ -2,6 +2,7 @@
 #define SRC_PARSER_TOKEN_H_
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <vector>
 #include <ostream>
@@ -70,13 +71,14 @@ struct Token
 {
     static const std::vector<const char*> types;
 
-    typedef Variant<std::string, uint64_t> Lexeme;
+    typedef Variant<std::string_view, uint64_t> Lexeme;
 
     Span span;
 
     TokenType type;
 
-    // Contains a string if the type is WHITESPACE, IDENT, COMMENT, INTEGER or UNKNOWN.
+    // Contains a slice of the source if the type is WHITESPACE, IDENT, COMMENT or UNKNOWN,
+    // and the value if it is INTEGER.
     Lexeme lexeme;
 
     template <typename T, typename... Args>
@@ -102,7 +104,7 @@ struct Token
 
     bool hasText() const;
 
-    std::unique_ptr<DataTypeBase> asDataType();
+    const DataTypeBase* asDataType();
 
     template <TokenType T>
     bool isType() const
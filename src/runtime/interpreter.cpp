@@ -0,0 +1,116 @@
+#include "runtime/interpreter.h"
+#include "except/exceptions.h"
+
+#include <istream>
+#include <ostream>
+
+Interpreter::Interpreter(size_t tape_size):
+    tape_size(tape_size), executed(0) {}
+
+void Interpreter::run(const Program& program, std::istream& input, std::ostream& output)
+{
+    //Direct threading: every instruction is translated to the address of its handler,
+    //so dispatching is a single indirect jump at the end of each handler
+    struct Threaded
+    {
+        const void* handler;
+        int32_t argument;
+        int32_t offset;
+    };
+
+    static const void* const handlers[] = {
+        &&op_add,
+        &&op_set,
+        &&op_multiply,
+        &&op_move,
+        &&op_jump_if_zero,
+        &&op_jump_unless_zero,
+        &&op_output,
+        &&op_input,
+        &&op_halt
+    };
+
+    const std::vector<Instruction>& code = program.getCode();
+    std::vector<Threaded> threaded;
+    threaded.reserve(code.size());
+    for(const Instruction& instruction : code)
+        threaded.push_back({handlers[(size_t)instruction.op], instruction.argument, instruction.offset});
+
+    //Offsets may reach past either end of the tape without the pointer ever
+    //leaving it, so pad both sides to keep those accesses in bounds
+    const size_t padding = program.getReach();
+    std::vector<uint8_t> cells(this->tape_size + 2 * padding);
+
+    std::streambuf* in = input.rdbuf();
+    std::streambuf* out = output.rdbuf();
+    uint8_t* tape = cells.data() + padding;
+    const size_t tape_size = this->tape_size;
+    const Threaded* start = threaded.data();
+    const Threaded* ip = start;
+    size_t pointer = 0;
+    uint64_t executed = 0;
+
+    #define DISPATCH() do { ++executed; goto *ip->handler; } while(0)
+
+    DISPATCH();
+
+op_add:
+    tape[pointer + ip->offset] += ip->argument;
+    ++ip;
+    DISPATCH();
+
+op_set:
+    tape[pointer + ip->offset] = ip->argument;
+    ++ip;
+    DISPATCH();
+
+op_multiply:
+    tape[pointer + ip->offset] += tape[pointer] * ip->argument;
+    ++ip;
+    DISPATCH();
+
+op_move:
+    //Moving below zero wraps around and is caught here as well
+    pointer += ip->argument;
+    if(pointer >= tape_size)
+    {
+        this->executed = executed;
+        throw RuntimeException("Stack pointer moved outside of the tape");
+    }
+    ++ip;
+    DISPATCH();
+
+op_jump_if_zero:
+    ip = tape[pointer] == 0 ? start + ip->argument : ip + 1;
+    DISPATCH();
+
+op_jump_unless_zero:
+    ip = tape[pointer] != 0 ? start + ip->argument : ip + 1;
+    DISPATCH();
+
+op_output:
+    out->sputc(tape[pointer + ip->offset]);
+    ++ip;
+    DISPATCH();
+
+op_input:
+{
+    //Cells are left untouched at end of input
+    int c = in->sbumpc();
+    if(c != std::char_traits<char>::eof())
+        tape[pointer + ip->offset] = c;
+    ++ip;
+    DISPATCH();
+}
+
+op_halt:
+    #undef DISPATCH
+
+    this->executed = executed;
+    output.flush();
+}
+
+uint64_t Interpreter::getExecutedInstructions() const
+{
+    return this->executed;
+}
@@ -0,0 +1,26 @@
+#ifndef SRC_RUNTIME_INTERPRETER_H_
+#define SRC_RUNTIME_INTERPRETER_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include "runtime/program.h"
+
+const size_t DEFAULT_TAPE_SIZE = 1 << 16;
+
+class Interpreter
+{
+    private:
+        size_t tape_size;
+        uint64_t executed;
+    public:
+        Interpreter(size_t tape_size = DEFAULT_TAPE_SIZE);
+        ~Interpreter() = default;
+
+        //Runs the program on a zeroed tape
+        void run(const Program&, std::istream&, std::ostream&);
+
+        //Number of decoded instructions executed by the last run
+        uint64_t getExecutedInstructions() const;
+};
+
+#endif
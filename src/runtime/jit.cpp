@@ -0,0 +1,273 @@
+#include "runtime/jit.h"
+#include "except/exceptions.h"
+#include "common/util.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_AVAILABLE
+#include <sys/mman.h>
+#endif
+
+//Register usage of the generated code:
+//  rbx  pointer to the current cell
+//  r12  Context pointer handed to the I/O helpers
+//  r13  first cell of the tape
+//  r14  one past the last cell of the tape
+//All four are callee saved, so calls into the helpers leave them intact.
+class X86Assembler
+{
+    public:
+        std::vector<uint8_t> code;
+
+        static const uint8_t JB = 0x82;
+        static const uint8_t JAE = 0x83;
+        static const uint8_t JE = 0x84;
+        static const uint8_t JNE = 0x85;
+
+        void emit(std::initializer_list<uint8_t> bytes)
+        {
+            this->code.insert(this->code.end(), bytes);
+        }
+
+        void emit32(int32_t value)
+        {
+            uint8_t bytes[4];
+            std::memcpy(bytes, &value, 4);
+            this->code.insert(this->code.end(), bytes, bytes + 4);
+        }
+
+        void emit64(uint64_t value)
+        {
+            uint8_t bytes[8];
+            std::memcpy(bytes, &value, 8);
+            this->code.insert(this->code.end(), bytes, bytes + 8);
+        }
+
+        size_t position() const
+        {
+            return this->code.size();
+        }
+
+        //ModRM (and displacement) for the byte operand [rbx + offset]
+        void cell(uint8_t reg, int32_t offset)
+        {
+            if(offset == 0)
+                this->emit({(uint8_t)((reg << 3) | 0x03)});
+            else if(offset >= -128 && offset <= 127)
+                this->emit({(uint8_t)(0x40 | (reg << 3) | 0x03), (uint8_t)offset});
+            else
+            {
+                this->emit({(uint8_t)(0x80 | (reg << 3) | 0x03)});
+                this->emit32(offset);
+            }
+        }
+
+        //Conditional jump with a displacement to be patched later, returns its position
+        size_t jump(uint8_t condition)
+        {
+            this->emit({0x0F, condition});
+            this->emit32(0);
+            return this->position() - 4;
+        }
+
+        void patch(size_t displacement, size_t target)
+        {
+            int32_t relative = (int32_t)(target - (displacement + 4));
+            std::memcpy(&this->code[displacement], &relative, 4);
+        }
+
+        void call(const void* function)
+        {
+            //mov rdi, r12
+            this->emit({0x4C, 0x89, 0xE7});
+            //mov rax, function; call rax
+            this->emit({0x48, 0xB8});
+            this->emit64((uint64_t)function);
+            this->emit({0xFF, 0xD0});
+        }
+};
+
+JitCompiler::JitCompiler(size_t tape_size):
+    tape_size(tape_size) {}
+
+bool JitCompiler::isSupported()
+{
+#ifdef JIT_AVAILABLE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void JitCompiler::output(Context* context, int c)
+{
+    context->output->sputc(c);
+}
+
+void JitCompiler::input(Context* context, uint8_t* cell)
+{
+    //Cells are left untouched at end of input
+    int c = context->input->sbumpc();
+    if(c != std::char_traits<char>::eof())
+        *cell = c;
+}
+
+std::vector<uint8_t> JitCompiler::compile(const Program& program)
+{
+    X86Assembler a;
+    std::vector<size_t> loops;
+    std::vector<size_t> out_of_bounds;
+
+    //push rbx; push r12; push r13; push r14; sub rsp, 8 (keeps calls 16 byte aligned)
+    a.emit({0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x48, 0x83, 0xEC, 0x08});
+    //mov rbx, rdi; mov r12, rsi; mov r13, rdx; mov r14, rcx
+    a.emit({0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4, 0x49, 0x89, 0xD5, 0x49, 0x89, 0xCE});
+
+    for(const Instruction& instruction : program.getCode())
+    {
+        switch(instruction.op)
+        {
+            case OpCode::ADD:
+                //add byte [rbx+offset], amount
+                a.emit({0x80});
+                a.cell(0, instruction.offset);
+                a.emit({(uint8_t)instruction.argument});
+                break;
+            case OpCode::SET:
+                //mov byte [rbx+offset], value
+                a.emit({0xC6});
+                a.cell(0, instruction.offset);
+                a.emit({(uint8_t)instruction.argument});
+                break;
+            case OpCode::MULTIPLY:
+                //movzx eax, byte [rbx]
+                a.emit({0x0F, 0xB6, 0x03});
+                if(instruction.argument == 0xFF)
+                {
+                    //sub byte [rbx+offset], al
+                    a.emit({0x28});
+                    a.cell(0, instruction.offset);
+                    break;
+                }
+                //imul eax, eax, factor
+                if(instruction.argument != 1)
+                {
+                    a.emit({0x69, 0xC0});
+                    a.emit32(instruction.argument);
+                }
+                //add byte [rbx+offset], al
+                a.emit({0x00});
+                a.cell(0, instruction.offset);
+                break;
+            case OpCode::MOVE:
+                //add rbx, distance
+                if(instruction.argument >= -128 && instruction.argument <= 127)
+                    a.emit({0x48, 0x83, 0xC3, (uint8_t)instruction.argument});
+                else
+                {
+                    a.emit({0x48, 0x81, 0xC3});
+                    a.emit32(instruction.argument);
+                }
+                //cmp rbx, r14; jae out_of_bounds or cmp rbx, r13; jb out_of_bounds
+                if(instruction.argument > 0)
+                {
+                    a.emit({0x4C, 0x39, 0xF3});
+                    out_of_bounds.push_back(a.jump(X86Assembler::JAE));
+                }
+                else
+                {
+                    a.emit({0x4C, 0x39, 0xEB});
+                    out_of_bounds.push_back(a.jump(X86Assembler::JB));
+                }
+                break;
+            case OpCode::JUMP_IF_ZERO:
+                //cmp byte [rbx], 0; je after the loop
+                a.emit({0x80, 0x3B, 0x00});
+                loops.push_back(a.jump(X86Assembler::JE));
+                break;
+            case OpCode::JUMP_UNLESS_ZERO:
+            {
+                size_t open = loops.back();
+                loops.pop_back();
+                //cmp byte [rbx], 0; jne to the start of the loop body
+                a.emit({0x80, 0x3B, 0x00});
+                a.patch(a.jump(X86Assembler::JNE), open + 4);
+                a.patch(open, a.position());
+                break;
+            }
+            case OpCode::OUTPUT:
+                //movzx esi, byte [rbx+offset]
+                a.emit({0x0F, 0xB6});
+                a.cell(6, instruction.offset);
+                a.call((const void*)&JitCompiler::output);
+                break;
+            case OpCode::INPUT:
+                //lea rsi, [rbx+offset]
+                a.emit({0x48, 0x8D});
+                a.cell(6, instruction.offset);
+                a.call((const void*)&JitCompiler::input);
+                break;
+            case OpCode::HALT:
+                //xor eax, eax
+                a.emit({0x31, 0xC0});
+                break;
+        }
+    }
+
+    size_t epilogue = a.position();
+    //add rsp, 8; pop r14; pop r13; pop r12; pop rbx; ret
+    a.emit({0x48, 0x83, 0xC4, 0x08, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3});
+
+    //mov eax, 1; jmp epilogue
+    size_t failure = a.position();
+    a.emit({0xB8, 0x01, 0x00, 0x00, 0x00, 0xE9});
+    a.emit32(0);
+    a.patch(a.position() - 4, epilogue);
+
+    for(size_t displacement : out_of_bounds)
+        a.patch(displacement, failure);
+
+    return a.code;
+}
+
+bool JitCompiler::run(const Program& program, std::istream& input, std::ostream& output)
+{
+#ifdef JIT_AVAILABLE
+    std::vector<uint8_t> code = this->compile(program);
+
+    //Written while writable, then flipped to executable; never both at once
+    void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED)
+        return false;
+    std::memcpy(memory, code.data(), code.size());
+    if(mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, code.size());
+        return false;
+    }
+
+    //Same padding as the interpreter, offsets are not bounds checked
+    const size_t padding = program.getReach();
+    std::vector<uint8_t> cells(this->tape_size + 2 * padding);
+    uint8_t* tape = cells.data() + padding;
+
+    Context context{input.rdbuf(), output.rdbuf()};
+    EntryPoint entry = reinterpret_cast<EntryPoint>(memory);
+    int status = entry(tape, &context, tape, tape + this->tape_size);
+
+    munmap(memory, code.size());
+    output.flush();
+
+    if(status != 0)
+        throw RuntimeException("Stack pointer moved outside of the tape");
+    return true;
+#else
+    UNUSED(program);
+    UNUSED(input);
+    UNUSED(output);
+    return false;
+#endif
+}
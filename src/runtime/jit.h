@@ -0,0 +1,41 @@
+#ifndef SRC_RUNTIME_JIT_H_
+#define SRC_RUNTIME_JIT_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "runtime/program.h"
+#include "runtime/interpreter.h"
+
+//Translates a decoded program to x86-64 machine code and runs it natively.
+//Only available on x86-64 Linux; everywhere else run() reports failure and the
+//caller is expected to fall back to the Interpreter.
+class JitCompiler
+{
+    private:
+        struct Context
+        {
+            std::streambuf* input;
+            std::streambuf* output;
+        };
+
+        typedef int (*EntryPoint)(uint8_t*, Context*, uint8_t*, uint8_t*);
+
+        size_t tape_size;
+
+        static void output(Context*, int);
+        static void input(Context*, uint8_t*);
+
+        std::vector<uint8_t> compile(const Program&);
+    public:
+        JitCompiler(size_t tape_size = DEFAULT_TAPE_SIZE);
+        ~JitCompiler() = default;
+
+        static bool isSupported();
+
+        //Runs the program on a zeroed tape. Returns false if no native code
+        //could be produced, in which case nothing was executed.
+        bool run(const Program&, std::istream&, std::ostream&);
+};
+
+#endif
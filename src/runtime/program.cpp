@@ -0,0 +1,168 @@
+#include "runtime/program.h"
+#include "except/exceptions.h"
+
+#include <cstdlib>
+#include <map>
+
+Program::Program(const std::string& source):
+    reach(0)
+{
+    std::string filtered;
+    for(char c : source)
+    {
+        switch(c)
+        {
+            case '+': case '-': case '<': case '>':
+            case '[': case ']': case '.': case ',':
+                filtered.append(1, c);
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::vector<size_t> loops;
+    int32_t offset = 0;
+
+    for(size_t i = 0; i < filtered.size(); ++i)
+    {
+        switch(filtered[i])
+        {
+            case '+':
+                this->add(offset, 1);
+                break;
+            case '-':
+                this->add(offset, -1);
+                break;
+            case '>':
+                ++offset;
+                break;
+            case '<':
+                --offset;
+                break;
+            case '[':
+                //[-] and [+] just zero the cell
+                if(filtered.compare(i, 3, "[-]") == 0 || filtered.compare(i, 3, "[+]") == 0)
+                {
+                    this->set(offset, 0);
+                    i += 2;
+                    break;
+                }
+                if(offset != 0)
+                    this->code.push_back({OpCode::MOVE, offset, 0});
+                offset = 0;
+                loops.push_back(this->code.size());
+                this->code.push_back({OpCode::JUMP_IF_ZERO, 0, 0});
+                break;
+            case ']':
+            {
+                if(loops.empty())
+                    throw RuntimeException("Unmatched ']' in program");
+                size_t open = loops.back();
+                loops.pop_back();
+                if(offset == 0 && this->lowerTransferLoop(open))
+                    break;
+                if(offset != 0)
+                    this->code.push_back({OpCode::MOVE, offset, 0});
+                offset = 0;
+                this->code.push_back({OpCode::JUMP_UNLESS_ZERO, (int32_t)(open + 1), 0});
+                this->code[open].argument = (int32_t)this->code.size();
+                break;
+            }
+            case '.':
+                this->access(offset);
+                this->code.push_back({OpCode::OUTPUT, 0, offset});
+                break;
+            case ',':
+                this->access(offset);
+                this->code.push_back({OpCode::INPUT, 0, offset});
+                break;
+        }
+    }
+
+    if(!loops.empty())
+        throw RuntimeException("Unmatched '[' in program");
+
+    if(offset != 0)
+        this->code.push_back({OpCode::MOVE, offset, 0});
+    this->code.push_back({OpCode::HALT, 0, 0});
+}
+
+void Program::add(int32_t offset, int32_t amount)
+{
+    this->access(offset);
+    if(!this->code.empty() && this->code.back().offset == offset)
+    {
+        Instruction& last = this->code.back();
+        if(last.op == OpCode::ADD)
+        {
+            last.argument = (last.argument + amount) & 0xFF;
+            if(last.argument == 0)
+                this->code.pop_back();
+            return;
+        }
+        if(last.op == OpCode::SET)
+        {
+            last.argument = (last.argument + amount) & 0xFF;
+            return;
+        }
+    }
+    this->code.push_back({OpCode::ADD, amount & 0xFF, offset});
+}
+
+void Program::set(int32_t offset, int32_t value)
+{
+    this->access(offset);
+    //Whatever was added to the cell right before is overwritten anyway
+    if(!this->code.empty() && this->code.back().offset == offset &&
+       (this->code.back().op == OpCode::ADD || this->code.back().op == OpCode::SET))
+        this->code.pop_back();
+    this->code.push_back({OpCode::SET, value, offset});
+}
+
+void Program::access(int32_t offset)
+{
+    int32_t distance = std::abs(offset);
+    if(distance > this->reach)
+        this->reach = distance;
+}
+
+//Loops such as [->+>+++<<] only add multiples of the loop cell to its neighbours
+//and count the loop cell down to zero; they run in one step per target cell
+//instead of one iteration per unit of the loop cell's value
+bool Program::lowerTransferLoop(size_t open)
+{
+    std::map<int32_t, int32_t> factors;
+    for(size_t i = open + 1; i < this->code.size(); ++i)
+    {
+        if(this->code[i].op != OpCode::ADD)
+            return false;
+        factors[this->code[i].offset] += this->code[i].argument;
+    }
+
+    //With a step of +1 the loop runs 256 - x times, which is -x modulo 256
+    int32_t step = factors[0] & 0xFF;
+    if(step != 0xFF && step != 0x01)
+        return false;
+    factors.erase(0);
+
+    this->code.resize(open);
+    for(auto& it : factors)
+    {
+        int32_t factor = (step == 0xFF ? it.second : -it.second) & 0xFF;
+        if(factor != 0)
+            this->code.push_back({OpCode::MULTIPLY, factor, it.first});
+    }
+    this->set(0, 0);
+    return true;
+}
+
+const std::vector<Instruction>& Program::getCode() const
+{
+    return this->code;
+}
+
+int32_t Program::getReach() const
+{
+    return this->reach;
+}
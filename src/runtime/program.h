@@ -0,0 +1,54 @@
+#ifndef SRC_RUNTIME_PROGRAM_H_
+#define SRC_RUNTIME_PROGRAM_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class OpCode : uint8_t
+{
+    ADD,
+    SET,
+    MULTIPLY,
+    MOVE,
+    JUMP_IF_ZERO,
+    JUMP_UNLESS_ZERO,
+    OUTPUT,
+    INPUT,
+    HALT
+};
+
+//Pointer movement inside straight-line code is folded into the offset of the
+//cell an instruction works on, so only MOVE and jumps ever change the pointer.
+//ADD and SET carry an amount, MOVE its distance, and jumps the index of the
+//instruction following their matching bracket. MULTIPLY adds the current cell
+//times its argument to the cell at its offset.
+struct Instruction
+{
+    OpCode op;
+    int32_t argument;
+    int32_t offset;
+};
+
+//Brainfuck code decoded into a compact instruction stream
+class Program
+{
+    private:
+        std::vector<Instruction> code;
+        int32_t reach;
+
+        void add(int32_t, int32_t);
+        void set(int32_t, int32_t);
+        void access(int32_t);
+        bool lowerTransferLoop(size_t);
+    public:
+        Program(const std::string&);
+        ~Program() = default;
+
+        const std::vector<Instruction>& getCode() const;
+
+        //Largest distance between the pointer and a cell accessed through an offset
+        int32_t getReach() const;
+};
+
+#endif
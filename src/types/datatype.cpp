@@ -1,6 +1,7 @@
 #include "datatype.h"
 #include "common/util.h"
 #include "generator/brainfuck.h"
+#include "except/exceptions.h"
 
 #include <iostream>
 
@@ -19,7 +20,7 @@ const size_t DATATYPE_SIZES[] = {
 DataTypeBase::DataTypeBase(DataTypeClass type):
     type(type) {}
 
-DataType<DataTypeClass::STRUCT_FORWARD>::DataType(const std::string& name):
+DataType<DataTypeClass::STRUCT_FORWARD>::DataType(Symbol name):
     DataTypeBase(DataTypeClass::STRUCT_FORWARD), name(name) {}
 
 template <>
@@ -41,23 +42,11 @@ bool DataType<DataTypeClass::VOID>::canCastFrom(const DataTypeBase& type) const
     return true;
 }
 
-DataType<DataTypeClass::STRUCT_FORWARD>* DataType<DataTypeClass::STRUCT_FORWARD>::copy() const
-{
-    return new DataType<DataTypeClass::STRUCT_FORWARD>(this->name);
-}
-
 void DataType<DataTypeClass::STRUCT_FORWARD>::print(std::ostream& os) const
 {
     os << "struct " << this->name;
 }
 
-bool DataType<DataTypeClass::STRUCT_FORWARD>::equals(const DataTypeBase& other) const
-{
-    if(other.type == DataTypeClass::STRUCT_FORWARD)
-        return this->name == ((const DataType<DataTypeClass::STRUCT_FORWARD>&)other).name;
-    return false;
-}
-
 bool DataType<DataTypeClass::STRUCT_FORWARD>::isBoolean() const
 {
     return false;
@@ -76,7 +65,25 @@ bool DataType<DataTypeClass::STRUCT_FORWARD>::canCastFrom(const DataTypeBase& ty
 
 size_t DataType<DataTypeClass::STRUCT_FORWARD>::size(BrainfuckWriter& writer) const
 {
-    return writer.getDeclaredStructure(this->name)->size(writer);
+    StructureDefinition* definition = writer.getDeclaredStructure(this->name);
+    if(definition == nullptr)
+        throw TypeCheckException("Use of undeclared structure " + this->name.str());
+    return definition->size(writer);
+}
+
+std::map<Symbol, std::unique_ptr<DataType<DataTypeClass::STRUCT_FORWARD>>>& TypeTable::structures()
+{
+    static std::map<Symbol, std::unique_ptr<DataType<DataTypeClass::STRUCT_FORWARD>>> table;
+    return table;
+}
+
+const DataType<DataTypeClass::STRUCT_FORWARD>* TypeTable::getStructure(Symbol name)
+{
+    auto& table = TypeTable::structures();
+    auto it = table.find(name);
+    if(it == table.end())
+        it = table.emplace(name, std::unique_ptr<DataType<DataTypeClass::STRUCT_FORWARD>>(new DataType<DataTypeClass::STRUCT_FORWARD>(name))).first;
+    return it->second.get();
 }
 
 std::ostream& operator<<(std::ostream& os, const DataTypeBase& datatype)
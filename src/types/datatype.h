@@ -3,7 +3,9 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <iosfwd>
+#include "common/symbol.h"
 
 class BrainfuckWriter;
 
@@ -17,17 +19,20 @@ enum class DataTypeClass
 extern const char* DATATYPE_NAMES[];
 extern const size_t DATATYPE_SIZES[];
 
+//Types are immutable and interned by the TypeTable, so two types are the
+//same exactly when their pointers are equal
 class DataTypeBase
 {
     protected:
         DataTypeBase(DataTypeClass);
     public:
+        DataTypeBase(const DataTypeBase&) = delete;
         virtual ~DataTypeBase() = default;
-        DataTypeClass type;
+        const DataTypeClass type;
+
+        DataTypeBase& operator=(const DataTypeBase&) = delete;
 
-        virtual DataTypeBase* copy() const = 0;
         virtual void print(std::ostream&) const = 0;
-        virtual bool equals(const DataTypeBase&) const = 0;
         virtual bool isBoolean() const = 0;
         virtual bool supportsArithmetic() const = 0;
         virtual bool canCastFrom(const DataTypeBase&) const = 0;
@@ -37,13 +42,14 @@ class DataTypeBase
 template <DataTypeClass dtype>
 class DataType : public DataTypeBase
 {
-    public:
+    private:
         DataType();
+
+        friend class TypeTable;
+    public:
         virtual ~DataType() = default;
 
-        virtual DataType<dtype>* copy() const;
         virtual void print(std::ostream&) const;
-        virtual bool equals(const DataTypeBase&) const;
         virtual bool isBoolean() const;
         virtual bool supportsArithmetic() const;
         virtual bool canCastFrom(const DataTypeBase&) const;
@@ -53,15 +59,16 @@ class DataType : public DataTypeBase
 template<>
 class DataType<DataTypeClass::STRUCT_FORWARD> : public DataTypeBase
 {
+    private:
+        DataType(Symbol);
+
+        friend class TypeTable;
     public:
-        std::string name;
+        const Symbol name;
 
-        DataType(const std::string&);
         virtual ~DataType() = default;
 
-        virtual DataType<DataTypeClass::STRUCT_FORWARD>* copy() const;
         virtual void print(std::ostream&) const;
-        virtual bool equals(const DataTypeBase&) const;
         virtual bool isBoolean() const;
         virtual bool supportsArithmetic() const;
         virtual bool canCastFrom(const DataTypeBase&) const;
@@ -75,6 +82,18 @@ bool DataType<DataTypeClass::VOID>::supportsArithmetic() const;
 template<>
 bool DataType<DataTypeClass::VOID>::canCastFrom(const DataTypeBase&) const;
 
+//Hands out the single instance of every type
+class TypeTable
+{
+    private:
+        static std::map<Symbol, std::unique_ptr<DataType<DataTypeClass::STRUCT_FORWARD>>>& structures();
+    public:
+        template <DataTypeClass dtype>
+        static const DataType<dtype>* get();
+
+        static const DataType<DataTypeClass::STRUCT_FORWARD>* getStructure(Symbol);
+};
+
 std::ostream& operator<<(std::ostream&, const DataTypeBase&);
 
 #include "datatype.inl"
@@ -10,18 +10,6 @@ void DataType<dtype>::print(std::ostream& os) const
     os << DATATYPE_NAMES[(size_t)dtype];
 }
 
-template <DataTypeClass dtype>
-DataType<dtype>* DataType<dtype>::copy() const
-{
-    return new DataType<dtype>();
-}
-
-template <DataTypeClass dtype>
-bool DataType<dtype>::equals(const DataTypeBase& other) const
-{
-    return other.type == dtype;
-}
-
 template <DataTypeClass dtype>
 bool DataType<dtype>::isBoolean() const
 {
@@ -46,3 +34,10 @@ size_t DataType<dtype>::size(BrainfuckWriter& writer) const
     UNUSED(writer);
     return DATATYPE_SIZES[(size_t)dtype];
 }
+
+template <DataTypeClass dtype>
+const DataType<dtype>* TypeTable::get()
+{
+    static const DataType<dtype> instance;
+    return &instance;
+}